@@ -20,6 +20,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <units/format.h>
 #include <units/velocity.h>
 #include <iostream>
 
@@ -37,8 +38,8 @@ template<units::Velocity V, units::Time T>
 void example_1(V v, T t)
 {
   const units::Length distance = v * t;
-  std::cout << "A car driving " << v.count() << " km/h in a time of " << t.count() << " minutes will pass "
-            << units::quantity_cast<units::length<units::meter, double>>(distance).count() << " meters.\n";
+  std::cout << "A car driving " << v << " in a time of " << t << " will pass "
+            << units::quantity_cast<units::length<units::meter, double>>(distance) << ".\n";
 }
 
 void example_2(double distance_v, double duration_v)
@@ -46,8 +47,8 @@ void example_2(double distance_v, double duration_v)
   units::length<units::kilometer> distance(distance_v);
   units::time<units::hour> duration(duration_v);
   const auto kmph = avg_speed(distance, duration);
-  std::cout << "Average speed of a car that makes " << distance.count() << " km in "
-            << duration.count() << " hours is " << kmph.count() << " km/h.\n";
+  std::cout << "Average speed of a car that makes " << distance << " in "
+            << duration << " is " << kmph << ".\n";
 }
 
 }
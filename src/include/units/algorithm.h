@@ -0,0 +1,259 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/quantity_span.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+namespace units {
+
+  namespace detail {
+
+    template<typename Compare>
+    inline constexpr bool is_threshold_comparison =
+        std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less_equal<>> ||
+        std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater_equal<>> ||
+        std::is_same_v<Compare, std::equal_to<>>;
+
+    // wide enough for the exact product of a 64-bit count and a ratio numerator where available;
+    // products overflowing the fallback are rounded through long double instead
+#ifdef __SIZEOF_INT128__
+    using wide_int = __int128;
+    using wide_uint = unsigned __int128;
+#else
+    using wide_int = std::intmax_t;
+    using wide_uint = std::uintmax_t;
+#endif
+
+    [[nodiscard]] constexpr wide_int floor_div(wide_int a, wide_int b) noexcept
+    {
+      const wide_int q = a / b;
+      return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+    }
+
+    [[nodiscard]] constexpr wide_int ceil_div(wide_int a, wide_int b) noexcept
+    {
+      const wide_int q = a / b;
+      return (a % b != 0 && (a < 0) == (b < 0)) ? q + 1 : q;
+    }
+
+    // integral value (the floor or the ceil of a threshold) in the range of Rep or below or above it
+    template<typename Rep>
+    struct rounded_rep {
+      int side;  // -1 below the range, 1 above it, 0 in the range
+      Rep value;
+    };
+
+    template<typename Rep>
+    [[nodiscard]] constexpr rounded_rep<Rep> round_to_rep(wide_int v) noexcept
+    {
+      if constexpr (std::is_signed_v<Rep>) {
+        if (v < std::numeric_limits<Rep>::min()) return {-1, 0};
+        if (v > std::numeric_limits<Rep>::max()) return {1, 0};
+      }
+      else {
+        if (v < 0) return {-1, 0};
+        if (static_cast<wide_uint>(v) > std::numeric_limits<Rep>::max()) return {1, 0};
+      }
+      return {0, static_cast<Rep>(v)};
+    }
+
+    // v has to be integral; the limits of Rep (-2^digits or 0 and 2^digits) are exact in long double
+    template<typename Rep>
+    [[nodiscard]] constexpr rounded_rep<Rep> round_to_rep(long double v) noexcept
+    {
+      constexpr long double above =
+          static_cast<long double>(std::uintmax_t(1) << (std::numeric_limits<Rep>::digits - 1)) * 2;
+      constexpr long double below = std::is_signed_v<Rep> ? -above : 0;
+      if (v < below) return {-1, 0};
+      if (v >= above) return {1, 0};
+      return {0, static_cast<Rep>(v)};
+    }
+
+  }  // namespace detail
+
+  // threshold_filter
+  //
+  // Predicate `compare(value, threshold)` over quantities of type Q with the threshold converted
+  // once to the unit of Q. For integral reps the exact (possibly fractional) threshold is turned
+  // into the closed interval [lo, hi] of the matching reps, rounding it up or down depending on the
+  // comparison, so every comparison costs the same two branchless integer compares. For floating-point
+  // reps the threshold is rounded to the rep and compared directly.
+
+  template<Quantity Q, typename Compare>
+      requires detail::is_threshold_comparison<Compare>
+  class threshold_filter {
+  public:
+    using rep = Q::rep;
+
+  private:
+    rep lo_;
+    rep hi_;  // unused for floating-point reps
+
+    static constexpr rep rep_min = std::numeric_limits<rep>::lowest();
+    static constexpr rep rep_max = std::numeric_limits<rep>::max();
+
+    constexpr void set_interval(rep lo, rep hi) noexcept
+    {
+      lo_ = lo;
+      hi_ = hi;
+    }
+
+    constexpr void set_empty() noexcept { set_interval(rep_max, rep_min); }
+
+    // interval of the reps matching the threshold with the given floor and ceil
+    constexpr void set_interval(detail::rounded_rep<rep> floor, detail::rounded_rep<rep> ceil, bool integral) noexcept
+    {
+      if constexpr (std::is_same_v<Compare, std::less<>>) {
+        if (ceil.side > 0) set_interval(rep_min, rep_max);
+        else if (ceil.side < 0 || ceil.value == rep_min) set_empty();
+        else set_interval(rep_min, ceil.value - 1);
+      }
+      else if constexpr (std::is_same_v<Compare, std::less_equal<>>) {
+        if (floor.side != 0) floor.side > 0 ? set_interval(rep_min, rep_max) : set_empty();
+        else set_interval(rep_min, floor.value);
+      }
+      else if constexpr (std::is_same_v<Compare, std::greater<>>) {
+        if (floor.side < 0) set_interval(rep_min, rep_max);
+        else if (floor.side > 0 || floor.value == rep_max) set_empty();
+        else set_interval(floor.value + 1, rep_max);
+      }
+      else if constexpr (std::is_same_v<Compare, std::greater_equal<>>) {
+        if (ceil.side != 0) ceil.side < 0 ? set_interval(rep_min, rep_max) : set_empty();
+        else set_interval(ceil.value, rep_max);
+      }
+      else {
+        if (integral && floor.side == 0) set_interval(floor.value, floor.value);
+        else set_empty();
+      }
+    }
+
+    // exact threshold `v` rounded through long double
+    constexpr void set_interval(long double v) noexcept
+    {
+      if (v != v)  // NaN matches nothing
+        set_empty();
+      else
+        set_interval(detail::round_to_rep<rep>(std::floor(v)), detail::round_to_rep<rep>(std::ceil(v)),
+                     std::floor(v) == v);
+    }
+
+  public:
+    template<Quantity T>
+        requires std::Same<typename T::dimension, typename Q::dimension>
+    constexpr threshold_filter(Compare, const T& threshold) noexcept : lo_{}, hi_{}
+    {
+      using r = ratio_divide<typename T::unit::ratio, typename Q::unit::ratio>;
+      using trep = T::rep;
+      using detail::wide_int;
+
+      if constexpr (treat_as_floating_point<rep>) {
+        lo_ = static_cast<rep>(static_cast<long double>(threshold.count()) * r::num / r::den);
+      }
+      else {
+        // exact threshold expressed as the fraction num / r::den (or as a long double)
+        const long double v = static_cast<long double>(threshold.count()) * r::num / r::den;
+        if constexpr (treat_as_floating_point<trep>)
+          set_interval(v);
+        else {
+          wide_int num;
+          if (__builtin_mul_overflow(threshold.count(), r::num, &num))
+            set_interval(v);
+          else
+            set_interval(detail::round_to_rep<rep>(detail::floor_div(num, r::den)),
+                         detail::round_to_rep<rep>(detail::ceil_div(num, r::den)), num % r::den == 0);
+        }
+      }
+    }
+
+    [[nodiscard]] constexpr bool matches(rep v) const noexcept
+    {
+      if constexpr (treat_as_floating_point<rep>)
+        return Compare{}(v, lo_);
+      else
+        return (lo_ <= v) & (v <= hi_);
+    }
+
+    [[nodiscard]] constexpr bool operator()(const Q& q) const noexcept { return matches(q.count()); }
+
+    // closed interval of the matching reps (integral reps only)
+    [[nodiscard]] constexpr rep lower() const noexcept requires(!treat_as_floating_point<rep>) { return lo_; }
+    [[nodiscard]] constexpr rep upper() const noexcept requires(!treat_as_floating_point<rep>) { return hi_; }
+  };
+
+  template<Quantity T, typename Compare>
+  threshold_filter(Compare, const T&) -> threshold_filter<T, Compare>;
+
+  // count_if
+  //
+  // Number of the values for which compare(value, threshold) holds.
+
+  template<typename Q, typename Compare, Quantity T>
+  [[nodiscard]] constexpr std::size_t count_if(quantity_span<Q> values, Compare compare, const T& threshold) noexcept
+      requires Quantity<std::remove_const_t<Q>>
+  {
+    const threshold_filter<std::remove_const_t<Q>, Compare> f(compare, threshold);
+    const Q* data = values.data();
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) count += f.matches(data[i].count());
+    return count;
+  }
+
+  // mask
+  //
+  // Writes compare(values[i], threshold) to out[i] and returns the number of the matching values.
+
+  template<typename Q, typename Compare, Quantity T>
+      requires Quantity<std::remove_const_t<Q>>
+  constexpr std::size_t mask(quantity_span<Q> values, Compare compare, const T& threshold, bool* out) noexcept
+  {
+    const threshold_filter<std::remove_const_t<Q>, Compare> f(compare, threshold);
+    const Q* data = values.data();
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      const bool m = f.matches(data[i].count());
+      out[i] = m;
+      count += m;
+    }
+    return count;
+  }
+
+  // partition
+  //
+  // Reorders the values so that the ones for which compare(value, threshold) holds precede the
+  // others. Returns the number of the matching values.
+
+  template<Quantity Q, typename Compare, Quantity T>
+  constexpr std::size_t partition(quantity_span<Q> values, Compare compare, const T& threshold)
+  {
+    const threshold_filter<Q, Compare> f(compare, threshold);
+    return static_cast<std::size_t>(std::partition(values.begin(), values.end(), f) - values.begin());
+  }
+
+}  // namespace units
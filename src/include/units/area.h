@@ -37,18 +37,28 @@ namespace units {
 
   struct square_millimeter : derived_unit<dimension_area, millimeter> {};
   template<> struct upcasting_traits<upcast_from<square_millimeter>> : upcast_to<square_millimeter> {};
+  template<> inline constexpr std::string_view unit_symbol<square_millimeter> = "mm²";
+  UNITS_EXTERN_QUANTITY(square_millimeter);
 
   struct square_centimeter : derived_unit<dimension_area, centimeter> {};
   template<> struct upcasting_traits<upcast_from<square_centimeter>> : upcast_to<square_centimeter> {};
+  template<> inline constexpr std::string_view unit_symbol<square_centimeter> = "cm²";
+  UNITS_EXTERN_QUANTITY(square_centimeter);
 
   struct square_meter : derived_unit<dimension_area, meter> {};
   template<> struct upcasting_traits<upcast_from<square_meter>> : upcast_to<square_meter> {};
+  template<> inline constexpr std::string_view unit_symbol<square_meter> = "m²";
+  UNITS_EXTERN_QUANTITY(square_meter);
 
   struct square_kilometer : derived_unit<dimension_area, kilometer, meter> {};
   template<> struct upcasting_traits<upcast_from<square_kilometer>> : upcast_to<square_kilometer> {};
+  template<> inline constexpr std::string_view unit_symbol<square_kilometer> = "km²";
+  UNITS_EXTERN_QUANTITY(square_kilometer);
 
   struct square_foot : derived_unit<dimension_area, foot> {};
   template<> struct upcasting_traits<upcast_from<square_foot>> : upcast_to<square_foot> {};
+  template<> inline constexpr std::string_view unit_symbol<square_foot> = "ft²";
+  UNITS_EXTERN_QUANTITY(square_foot);
 
   inline namespace literals {
 
@@ -0,0 +1,150 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/quantity.h>
+#include <atomic>
+#include <type_traits>
+
+namespace units {
+
+  // atomic_quantity
+  //
+  // Provides atomic operations on a quantity while keeping its dimension and unit in the type.
+  // Operands of the modifying operations may be given in any unit that is implicitly convertible
+  // to Q (i.e. the conversion does not truncate). Other units have to be quantity_cast explicitly
+  // by the user first.
+
+  template<Quantity Q>
+  class atomic_quantity {
+  public:
+    using value_type = Q;
+    using rep = Q::rep;
+
+  private:
+    std::atomic<rep> value_;
+
+    static constexpr rep add(const rep& lhs, const rep& rhs) { return lhs + rhs; }
+    static constexpr rep sub(const rep& lhs, const rep& rhs) { return lhs - rhs; }
+
+    template<rep (*Op)(const rep&, const rep&)>
+    Q fetch_op(const rep& v, std::memory_order order) noexcept
+    {
+      // floating-point and user-defined reps do not provide fetch_add/fetch_sub
+      rep old = value_.load(std::memory_order_relaxed);
+      while (!value_.compare_exchange_weak(old, Op(old, v), order, std::memory_order_relaxed)) {
+      }
+      return Q(old);
+    }
+
+  public:
+    static constexpr bool is_always_lock_free = std::atomic<rep>::is_always_lock_free;
+
+    atomic_quantity() noexcept : value_(quantity_values<rep>::zero()) {}
+    constexpr atomic_quantity(const Q& q) noexcept : value_(q.count()) {}
+    atomic_quantity(const atomic_quantity&) = delete;
+    atomic_quantity& operator=(const atomic_quantity&) = delete;
+
+    [[nodiscard]] bool is_lock_free() const noexcept { return value_.is_lock_free(); }
+
+    void store(const Q& q, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      value_.store(q.count(), order);
+    }
+
+    [[nodiscard]] Q load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+      return Q(value_.load(order));
+    }
+
+    operator Q() const noexcept { return load(); }
+
+    Q operator=(const Q& q) noexcept
+    {
+      store(q);
+      return q;
+    }
+
+    Q exchange(const Q& q, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      return Q(value_.exchange(q.count(), order));
+    }
+
+    bool compare_exchange_weak(Q& expected, const Q& desired, std::memory_order success,
+                               std::memory_order failure) noexcept
+    {
+      rep e = expected.count();
+      const bool result = value_.compare_exchange_weak(e, desired.count(), success, failure);
+      expected = Q(e);
+      return result;
+    }
+
+    bool compare_exchange_weak(Q& expected, const Q& desired,
+                               std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      rep e = expected.count();
+      const bool result = value_.compare_exchange_weak(e, desired.count(), order);
+      expected = Q(e);
+      return result;
+    }
+
+    bool compare_exchange_strong(Q& expected, const Q& desired, std::memory_order success,
+                                 std::memory_order failure) noexcept
+    {
+      rep e = expected.count();
+      const bool result = value_.compare_exchange_strong(e, desired.count(), success, failure);
+      expected = Q(e);
+      return result;
+    }
+
+    bool compare_exchange_strong(Q& expected, const Q& desired,
+                                 std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      rep e = expected.count();
+      const bool result = value_.compare_exchange_strong(e, desired.count(), order);
+      expected = Q(e);
+      return result;
+    }
+
+    Q fetch_add(const Q& q, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      if constexpr (std::is_integral_v<rep>)
+        return Q(value_.fetch_add(q.count(), order));
+      else
+        return fetch_op<add>(q.count(), order);
+    }
+
+    Q fetch_sub(const Q& q, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+      if constexpr (std::is_integral_v<rep>)
+        return Q(value_.fetch_sub(q.count(), order));
+      else
+        return fetch_op<sub>(q.count(), order);
+    }
+
+    Q operator+=(const Q& q) noexcept { return fetch_add(q) + q; }
+    Q operator-=(const Q& q) noexcept { return fetch_sub(q) - q; }
+  };
+
+}  // namespace units
@@ -0,0 +1,137 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+namespace units::detail {
+
+  // number_from_chars, number_to_chars
+  //
+  // std::from_chars and std::to_chars for all arithmetic types. The floating-point overloads of the
+  // standard ones are only provided by newer standard libraries (libstdc++ 11), older ones get a
+  // fallback based on the C library which honors LC_NUMERIC and does not parse "inf" and "nan".
+
+#ifdef __cpp_lib_to_chars
+
+  template<typename T>
+  std::from_chars_result number_from_chars(const char* first, const char* last, T& value) noexcept
+  {
+    return std::from_chars(first, last, value);
+  }
+
+  template<typename T>
+  std::to_chars_result number_to_chars(char* first, char* last, T value) noexcept
+  {
+    return std::to_chars(first, last, value);
+  }
+
+#else
+
+  template<typename T>
+  [[nodiscard]] T c_strto(const char* str, char** end) noexcept
+  {
+    if constexpr (std::is_same_v<T, float>)
+      return std::strtof(str, end);
+    else if constexpr (std::is_same_v<T, double>)
+      return std::strtod(str, end);
+    else
+      return std::strtold(str, end);
+  }
+
+  template<typename T>
+  std::from_chars_result number_from_chars(const char* first, const char* last, T& value) noexcept
+  {
+    if constexpr (std::is_integral_v<T>)
+      return std::from_chars(first, last, value);
+    else {
+      // the longest prefix matching the decimal floating-point grammar of std::from_chars
+      const auto digits = [&](const char* p) {
+        while (p != last && *p >= '0' && *p <= '9') ++p;
+        return p;
+      };
+      const char* p = first;
+      if (p != last && *p == '-') ++p;
+      const char* end = digits(p);
+      bool has_digits = end != p;
+      if (end != last && *end == '.') {
+        const char* fraction_end = digits(end + 1);
+        has_digits = has_digits || fraction_end != end + 1;
+        if (has_digits) end = fraction_end;
+      }
+      if (!has_digits) return {first, std::errc::invalid_argument};
+      if (end != last && (*end == 'e' || *end == 'E')) {
+        const char* e = end + 1;
+        if (e != last && (*e == '+' || *e == '-')) ++e;
+        if (const char* e_end = digits(e); e_end != e) end = e_end;
+      }
+
+      char buffer[128];
+      const auto size = static_cast<std::size_t>(end - first);
+      if (size >= sizeof(buffer)) return {first, std::errc::invalid_argument};
+      std::copy(first, end, buffer);
+      buffer[size] = '\0';
+      const int saved_errno = errno;
+      errno = 0;
+      const T result = c_strto<T>(buffer, nullptr);
+      const bool out_of_range = errno == ERANGE;
+      errno = saved_errno;
+      if (out_of_range) return {end, std::errc::result_out_of_range};
+      value = result;
+      return {end, std::errc()};
+    }
+  }
+
+  template<typename T>
+  std::to_chars_result number_to_chars(char* first, char* last, T value) noexcept
+  {
+    if constexpr (std::is_integral_v<T>)
+      return std::to_chars(first, last, value);
+    else {
+      // the shortest precision that round-trips
+      char buffer[64];
+      int size = 0;
+      for (int precision = std::numeric_limits<T>::digits10; precision <= std::numeric_limits<T>::max_digits10;
+           ++precision) {
+        if constexpr (std::is_same_v<T, long double>)
+          size = std::snprintf(buffer, sizeof(buffer), "%.*Lg", precision, value);
+        else
+          size = std::snprintf(buffer, sizeof(buffer), "%.*g", precision, static_cast<double>(value));
+        if (c_strto<T>(buffer, nullptr) == value) break;
+      }
+      if (size < 0 || last - first < size) return {last, std::errc::value_too_large};
+      return {std::copy(buffer, buffer + size, first), std::errc()};
+    }
+  }
+
+#endif
+
+}  // namespace units::detail
@@ -0,0 +1,100 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace units::detail {
+
+  // cache_line_size
+  //
+  // std::hardware_destructive_interference_size is not used on purpose as its value may differ between
+  // compilation flags which would make the layout of types using it part of an unstable ABI.
+
+  inline constexpr std::size_t cache_line_size = 64;
+
+  // cache_line_padded
+
+  template<typename T>
+  struct alignas(cache_line_size) cache_line_padded {
+    T value;
+  };
+
+  // this_thread_index
+  //
+  // Small, dense and stable per-thread index assigned on the first use in a thread.
+  // Used to pick a shard of a data structure without any synchronization.
+
+  inline std::size_t this_thread_index() noexcept
+  {
+    static std::atomic<std::size_t> next_index{0};
+    thread_local const std::size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+    return index;
+  }
+
+  // shard_count
+  //
+  // Rounds the requested number of shards up to the power of 2 so that shard selection is a mask.
+
+  [[nodiscard]] constexpr std::size_t shard_count(std::size_t requested) noexcept
+  {
+    std::size_t count = 1;
+    while (count < requested) count <<= 1;
+    return count;
+  }
+
+  // parallel_for
+  //
+  // Splits [first, last) into at most `threads` contiguous bands and calls f(band_first, band_last)
+  // for each of them. The last band runs on the calling thread. Returns when all bands are done.
+
+  template<typename F>
+  void parallel_for(std::size_t first, std::size_t last, std::size_t threads, F f)
+  {
+    const std::size_t count = last > first ? last - first : 0;
+    threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(count, 1));
+    if (threads == 1) {
+      if (count > 0) f(first, last);
+      return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    const std::size_t band = count / threads;
+    const std::size_t rest = count % threads;
+    std::size_t begin = first;
+    for (std::size_t t = 0; t < threads - 1; ++t) {
+      const std::size_t end = begin + band + (t < rest ? 1 : 0);
+      workers.emplace_back([&f, begin, end] { f(begin, end); });
+      begin = end;
+    }
+    f(begin, last);
+    for (auto& w : workers) w.join();
+  }
+
+}  // namespace units::detail
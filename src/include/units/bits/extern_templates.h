@@ -0,0 +1,44 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstdint>
+
+// UNITS_EXTERN_QUANTITY
+//
+// Every named unit declares the quantities of that unit with the reps produced by the literals
+// (std::int64_t and long double) and with double as explicit instantiations. With
+// UNITS_EXTERN_TEMPLATES defined (done by linking to the units_precompiled library) they become
+// `extern template` declarations so that the non-template member functions of those quantities are
+// not compiled again in every translation unit. Member functions stay available for inlining in
+// optimized builds; unoptimized builds call the precompiled ones.
+
+#ifdef UNITS_EXTERN_TEMPLATES
+#define UNITS_EXTERN_QUANTITY(U)                                         \
+  extern template class quantity<U::dimension, U, std::int64_t>;        \
+  extern template class quantity<U::dimension, U, double>;              \
+  extern template class quantity<U::dimension, U, long double>
+#else
+#define UNITS_EXTERN_QUANTITY(U) static_assert(true)
+#endif
@@ -0,0 +1,38 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+// UNITS_ALWAYS_INLINE
+//
+// By default the library relies on the optimizer to collapse the chain of tiny functions that
+// implement every quantity operation (converting constructor -> quantity_cast -> quantity_cast_impl::cast -> count()).
+// In unoptimized (-O0) builds each layer stays a real call, which makes debug builds of unit-heavy code
+// many times slower than the same code written with raw numbers. Defining UNITS_FORCE_INLINE asks the
+// compiler to inline those layers regardless of the optimization level.
+
+#if defined(UNITS_FORCE_INLINE) && defined(__GNUC__)
+#define UNITS_ALWAYS_INLINE __attribute__((always_inline))
+#else
+#define UNITS_ALWAYS_INLINE
+#endif
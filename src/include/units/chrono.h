@@ -0,0 +1,88 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/time.h>
+#include <chrono>
+#include <ratio>
+#include <thread>
+#include <utility>
+
+namespace units {
+
+  // std::chrono::duration <-> time
+  //
+  // Both representations store only the count of ticks so the conversions below only copy the count
+  // and compile to nothing. The unit of the resulting quantity is the named unit with the same ratio
+  // (if one is defined) i.e. std::chrono::milliseconds becomes time<millisecond, Rep>.
+
+  template<Scalar Rep, std::intmax_t Num, std::intmax_t Den>
+  [[nodiscard]] constexpr Time to_quantity(const std::chrono::duration<Rep, std::ratio<Num, Den>>& d)
+  {
+    using U = upcasting_traits_t<unit<dimension_time, ratio<Num, Den>>>;
+    return quantity<dimension_time, U, Rep>(d.count());
+  }
+
+  template<Unit U, Scalar Rep>
+  [[nodiscard]] constexpr auto to_std_duration(const quantity<dimension_time, U, Rep>& q)
+  {
+    return std::chrono::duration<Rep, std::ratio<U::ratio::num, U::ratio::den>>(q.count());
+  }
+
+  // std::chrono::time_point <-> time
+
+  template<typename Clock, typename Duration>
+  [[nodiscard]] constexpr Time time_since_epoch(const std::chrono::time_point<Clock, Duration>& tp)
+  {
+    return to_quantity(tp.time_since_epoch());
+  }
+
+  template<typename Clock, Unit U, Scalar Rep>
+  [[nodiscard]] constexpr auto to_std_time_point(const quantity<dimension_time, U, Rep>& since_epoch)
+  {
+    using duration = decltype(to_std_duration(since_epoch));
+    return std::chrono::time_point<Clock, duration>(to_std_duration(since_epoch));
+  }
+
+  // waiting
+
+  template<Unit U, Scalar Rep>
+  void sleep_for(const quantity<dimension_time, U, Rep>& t)
+  {
+    std::this_thread::sleep_for(to_std_duration(t));
+  }
+
+  template<typename ConditionVariable, typename Lock, Unit U, Scalar Rep>
+  auto wait_for(ConditionVariable& cv, Lock& lock, const quantity<dimension_time, U, Rep>& t)
+  {
+    return cv.wait_for(lock, to_std_duration(t));
+  }
+
+  template<typename ConditionVariable, typename Lock, Unit U, Scalar Rep, typename Predicate>
+  bool wait_for(ConditionVariable& cv, Lock& lock, const quantity<dimension_time, U, Rep>& t, Predicate pred)
+  {
+    return cv.wait_for(lock, to_std_duration(t), std::move(pred));
+  }
+
+}  // namespace units
@@ -0,0 +1,382 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/quantity_file.h>
+#include <units/quantity_span.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace units {
+
+  // compressed_quantities
+  //
+  // Gorilla-style compressed sequence of quantities tagged with the metadata of their type.
+  // Integer reps are encoded as delta-of-delta and floating-point reps as the XOR with the
+  // previous value. Bits are stored LSB first in 64-bit words.
+
+  struct compressed_quantities {
+    quantity_metadata metadata{};
+    std::uint64_t count = 0;
+    std::uint64_t bits = 0;
+    std::vector<std::uint64_t> words;
+
+    [[nodiscard]] std::size_t size() const noexcept { return static_cast<std::size_t>(count); }
+    [[nodiscard]] std::size_t size_bytes() const noexcept { return words.size() * sizeof(std::uint64_t); }
+  };
+
+  namespace detail {
+
+    class bit_writer {
+      std::vector<std::uint64_t> words_;
+      std::uint64_t bits_ = 0;
+
+    public:
+      // writes `count` (1 - 64) lowest bits of the value
+      void write(std::uint64_t value, unsigned count)
+      {
+        if (count < 64) value &= (std::uint64_t(1) << count) - 1;
+        const unsigned offset = static_cast<unsigned>(bits_ % 64);
+        if (offset == 0) words_.push_back(0);
+        words_.back() |= value << offset;
+        if (offset + count > 64) words_.push_back(value >> (64 - offset));
+        bits_ += count;
+      }
+
+      [[nodiscard]] std::uint64_t bits() const noexcept { return bits_; }
+      [[nodiscard]] std::vector<std::uint64_t>&& take() && noexcept { return std::move(words_); }
+    };
+
+    class bit_reader {
+      const std::uint64_t* words_;
+      std::uint64_t bits_;
+      std::uint64_t pos_ = 0;
+
+    public:
+      bit_reader(const std::uint64_t* words, std::uint64_t bits) noexcept : words_(words), bits_(bits) {}
+
+      std::uint64_t read(unsigned count)
+      {
+        if (count > bits_ - pos_) throw std::runtime_error("units: truncated compressed quantities");
+        const std::uint64_t word = pos_ / 64;
+        const unsigned offset = static_cast<unsigned>(pos_ % 64);
+        std::uint64_t value = words_[word] >> offset;
+        if (offset + count > 64) value |= words_[word + 1] << (64 - offset);
+        if (count < 64) value &= (std::uint64_t(1) << count) - 1;
+        pos_ += count;
+        return value;
+      }
+    };
+
+    [[nodiscard]] constexpr std::uint64_t zigzag_encode(std::int64_t v) noexcept
+    {
+      return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+    }
+
+    [[nodiscard]] constexpr std::int64_t zigzag_decode(std::uint64_t v) noexcept
+    {
+      return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+    }
+
+    // delta-of-delta of integer values
+    class delta_of_delta_codec {
+      std::uint64_t prev_ = 0;
+      std::uint64_t prev_delta_ = 0;
+      bool first_ = true;
+
+    public:
+      void encode(bit_writer& w, std::uint64_t value)
+      {
+        if (first_) {
+          w.write(value, 64);
+          first_ = false;
+        }
+        else {
+          const std::uint64_t delta = value - prev_;
+          const std::uint64_t dod = zigzag_encode(static_cast<std::int64_t>(delta - prev_delta_));
+          if (dod == 0)
+            w.write(0b0, 1);
+          else if (dod < (1u << 7))
+            w.write(0b01 | (dod << 2), 2 + 7);
+          else if (dod < (1u << 9))
+            w.write(0b011 | (dod << 3), 3 + 9);
+          else if (dod < (1u << 12))
+            w.write(0b0111 | (dod << 4), 4 + 12);
+          else {
+            w.write(0b1111, 4);
+            w.write(dod, 64);
+          }
+          prev_delta_ = delta;
+        }
+        prev_ = value;
+      }
+
+      std::uint64_t decode(bit_reader& r)
+      {
+        if (first_) {
+          first_ = false;
+          return prev_ = r.read(64);
+        }
+        std::uint64_t dod = 0;
+        if (r.read(1) == 0)
+          dod = 0;
+        else if (r.read(1) == 0)
+          dod = r.read(7);
+        else if (r.read(1) == 0)
+          dod = r.read(9);
+        else if (r.read(1) == 0)
+          dod = r.read(12);
+        else
+          dod = r.read(64);
+        prev_delta_ += static_cast<std::uint64_t>(zigzag_decode(dod));
+        return prev_ += prev_delta_;
+      }
+    };
+
+    // XOR with the previous value of Width-bit floating-point patterns
+    template<unsigned Width>
+    class xor_codec {
+      static_assert(Width == 32 || Width == 64);
+
+      std::uint64_t prev_ = 0;
+      unsigned leading_ = 0;
+      unsigned trailing_ = 0;
+      bool first_ = true;
+      bool has_window_ = false;
+
+      [[nodiscard]] static unsigned leading_zeros(std::uint64_t x) noexcept
+      {
+        return static_cast<unsigned>(__builtin_clzll(x)) - (64 - Width);
+      }
+
+    public:
+      void encode(bit_writer& w, std::uint64_t value)
+      {
+        const std::uint64_t x = value ^ prev_;
+        prev_ = value;
+        if (first_) {
+          w.write(value, Width);
+          first_ = false;
+          return;
+        }
+        if (x == 0) {
+          w.write(0b0, 1);
+          return;
+        }
+        const unsigned leading = std::min(leading_zeros(x), 31u);
+        const unsigned trailing = static_cast<unsigned>(__builtin_ctzll(x));
+        if (has_window_ && leading >= leading_ && trailing >= trailing_) {
+          w.write(0b01, 2);
+          w.write(x >> trailing_, Width - leading_ - trailing_);
+        }
+        else {
+          const unsigned length = Width - leading - trailing;
+          w.write(0b11 | (leading << 2) | ((length - 1) << 7), 2 + 5 + 6);
+          w.write(x >> trailing, length);
+          leading_ = leading;
+          trailing_ = trailing;
+          has_window_ = true;
+        }
+      }
+
+      std::uint64_t decode(bit_reader& r)
+      {
+        if (first_) {
+          first_ = false;
+          return prev_ = r.read(Width);
+        }
+        if (r.read(1) == 0) return prev_;
+        if (r.read(1) == 1) {
+          leading_ = static_cast<unsigned>(r.read(5));
+          trailing_ = Width - leading_ - (static_cast<unsigned>(r.read(6)) + 1);
+          has_window_ = true;
+        }
+        else if (!has_window_)
+          throw std::runtime_error("units: corrupted compressed quantities");
+        return prev_ ^= r.read(Width - leading_ - trailing_) << trailing_;
+      }
+    };
+
+    template<typename Rep>
+    using quantity_codec = conditional<treat_as_floating_point<Rep>, xor_codec<sizeof(Rep) * 8>, delta_of_delta_codec>;
+
+    // decodes all the values stored as Stored and converts them to To with the factor folded in
+    template<typename Stored, Quantity To>
+    void decompress_as(const compressed_quantities& c, quantity_span<To> out, std::int64_t num, std::int64_t den)
+    {
+      using rep = To::rep;
+      bit_reader reader(c.words.data(), c.bits);
+      quantity_codec<Stored> codec;
+      To* o = out.data();
+      const std::size_t n = c.size();
+
+      auto value = [&] {
+        const std::uint64_t bits = codec.decode(reader);
+        if constexpr (std::is_same_v<Stored, float>) {
+          float v;
+          const auto b = static_cast<std::uint32_t>(bits);
+          std::memcpy(&v, &b, sizeof(v));
+          return v;
+        }
+        else if constexpr (std::is_same_v<Stored, double>) {
+          double v;
+          std::memcpy(&v, &bits, sizeof(v));
+          return v;
+        }
+        else {
+          return static_cast<Stored>(bits);
+        }
+      };
+
+      if constexpr (treat_as_floating_point<rep>) {
+        using c_rep = std::common_type_t<rep, double>;
+        const c_rep factor = static_cast<c_rep>(num) / static_cast<c_rep>(den);
+        for (std::size_t i = 0; i < n; ++i) o[i] = To(static_cast<rep>(static_cast<c_rep>(value()) * factor));
+      }
+      else if constexpr (treat_as_floating_point<Stored>) {
+        for (std::size_t i = 0; i < n; ++i) o[i] = To(static_cast<rep>(value() * num / den));
+      }
+      else {
+        for (std::size_t i = 0; i < n; ++i) o[i] = To(static_cast<rep>(value() * num / den));
+      }
+    }
+
+  }  // namespace detail
+
+  // quantity_encoder
+  //
+  // Appends quantities of type Q to a compressed stream.
+
+  template<Quantity Q>
+  class quantity_encoder {
+    using rep = Q::rep;
+    static_assert(std::is_integral_v<rep> || std::is_same_v<rep, float> || std::is_same_v<rep, double>,
+                  "only integral, float and double reps can be compressed");
+
+    detail::bit_writer writer_;
+    detail::quantity_codec<rep> codec_;
+    std::uint64_t count_ = 0;
+
+  public:
+    void push(const Q& q)
+    {
+      codec_.encode(writer_, detail::to_bits(q.count()));
+      ++count_;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return static_cast<std::size_t>(count_); }
+    [[nodiscard]] std::size_t size_bytes() const noexcept { return (writer_.bits() + 7) / 8; }
+
+    [[nodiscard]] compressed_quantities finish() &&
+    {
+      const std::uint64_t bits = writer_.bits();
+      return compressed_quantities{make_quantity_metadata<Q>(), count_, bits, std::move(writer_).take()};
+    }
+  };
+
+  template<Quantity Q>
+  [[nodiscard]] compressed_quantities compress(quantity_span<const Q> values)
+  {
+    quantity_encoder<Q> encoder;
+    for (const Q& q : values) encoder.push(q);
+    return std::move(encoder).finish();
+  }
+
+  // decompress
+  //
+  // Decodes the stream straight into the unit of To. The stored dimension has to be the one of To,
+  // the rep and the unit may differ. Throws std::runtime_error on a mismatch or corrupted data.
+
+  template<Quantity To>
+  void decompress(const compressed_quantities& c, quantity_span<To> out)
+  {
+    Expects(out.size() == c.size());
+    constexpr quantity_metadata target = make_quantity_metadata<To>();
+    const quantity_metadata& m = c.metadata;
+    if (!m.has_same_dimension(target)) throw std::runtime_error("units::decompress: dimension mismatch");
+    const auto [num, den] = detail::conversion_ratio(m, target);
+
+    if (m.kind == rep_kind::floating_point && m.rep_size == sizeof(float))
+      detail::decompress_as<float>(c, out, num, den);
+    else if (m.kind == rep_kind::floating_point && m.rep_size == sizeof(double))
+      detail::decompress_as<double>(c, out, num, den);
+    else if (m.kind == rep_kind::signed_integer)
+      detail::decompress_as<std::int64_t>(c, out, num, den);
+    else if (m.kind == rep_kind::unsigned_integer)
+      detail::decompress_as<std::uint64_t>(c, out, num, den);
+    else
+      throw std::runtime_error("units::decompress: unsupported rep");
+  }
+
+  template<Quantity To>
+  [[nodiscard]] std::vector<To> decompress(const compressed_quantities& c)
+  {
+    std::vector<To> result(c.size());
+    decompress(c, quantity_span<To>(result.data(), result.size()));
+    return result;
+  }
+
+  // Stream serialization of compressed quantities
+
+  inline constexpr char compressed_quantities_magic[8] = {'U', 'N', 'I', 'T', 'S', 'G', 'O', 'R'};
+
+  inline void write_compressed(std::ostream& os, const compressed_quantities& c)
+  {
+    const std::uint64_t words = c.words.size();
+    os.write(compressed_quantities_magic, sizeof(compressed_quantities_magic));
+    os.write(reinterpret_cast<const char*>(&c.metadata), sizeof(c.metadata));
+    os.write(reinterpret_cast<const char*>(&c.count), sizeof(c.count));
+    os.write(reinterpret_cast<const char*>(&c.bits), sizeof(c.bits));
+    os.write(reinterpret_cast<const char*>(&words), sizeof(words));
+    os.write(reinterpret_cast<const char*>(c.words.data()), static_cast<std::streamsize>(c.size_bytes()));
+    if (!os) throw std::runtime_error("units::write_compressed: write error");
+  }
+
+  [[nodiscard]] inline compressed_quantities read_compressed(std::istream& is)
+  {
+    char magic[sizeof(compressed_quantities_magic)];
+    compressed_quantities c;
+    std::uint64_t words = 0;
+    is.read(magic, sizeof(magic));
+    is.read(reinterpret_cast<char*>(&c.metadata), sizeof(c.metadata));
+    is.read(reinterpret_cast<char*>(&c.count), sizeof(c.count));
+    is.read(reinterpret_cast<char*>(&c.bits), sizeof(c.bits));
+    is.read(reinterpret_cast<char*>(&words), sizeof(words));
+    if (!is || !std::equal(std::begin(magic), std::end(magic), std::begin(compressed_quantities_magic)))
+      throw std::runtime_error("units::read_compressed: not compressed quantities");
+    if (words != (c.bits + 63) / 64) throw std::runtime_error("units::read_compressed: corrupted header");
+    c.words.resize(static_cast<std::size_t>(words));
+    is.read(reinterpret_cast<char*>(c.words.data()), static_cast<std::streamsize>(c.size_bytes()));
+    if (!is) throw std::runtime_error("units::read_compressed: truncated data");
+    return c;
+  }
+
+}  // namespace units
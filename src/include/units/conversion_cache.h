@@ -0,0 +1,128 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/concurrency.h>
+#include <units/unit_registry.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace units {
+
+  // conversion_cache
+  //
+  // Concurrent cache of conversion factors between pairs of runtime unit ids. The table is
+  // a fixed size open-addressing hash table with bounded probing, so a lookup never waits for
+  // other threads and costs at most max_probe atomic loads. A miss computes the factor on the
+  // calling thread and tries to publish it; when the table is full the factor is simply not cached.
+
+  template<typename Registry = unit_registry>
+  class conversion_cache {
+  public:
+    static constexpr std::size_t max_probe = 16;
+
+  private:
+    // key of an empty slot is 0; the top bit marks a slot claimed by a writer still storing the factor
+    static constexpr std::uint64_t pending = std::uint64_t(1) << 63;
+
+    struct slot {
+      std::atomic<std::uint64_t> key{0};
+      std::atomic<double> factor{0};
+    };
+
+    std::unique_ptr<slot[]> slots_;
+    std::size_t mask_;
+    detail::cache_line_padded<std::atomic<std::size_t>> size_{0};
+
+    [[nodiscard]] static constexpr std::uint64_t make_key(unit_id from, unit_id to) noexcept
+    {
+      return ((std::uint64_t(from) << 32) | to) + 1;
+    }
+
+    [[nodiscard]] std::size_t home(std::uint64_t key) const noexcept
+    {
+      return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15u) >> 32) & mask_;
+    }
+
+    void insert(std::uint64_t key, double factor) noexcept
+    {
+      const std::size_t first = home(key);
+      for (std::size_t i = 0; i < max_probe; ++i) {
+        slot& s = slots_[(first + i) & mask_];
+        std::uint64_t current = s.key.load(std::memory_order_relaxed);
+        if (current == 0 && s.key.compare_exchange_strong(current, key | pending, std::memory_order_relaxed)) {
+          s.factor.store(factor, std::memory_order_relaxed);
+          s.key.store(key, std::memory_order_release);
+          size_.value.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+        if ((current & ~pending) == key) return;  // published (or being published) by another thread
+      }
+    }
+
+  public:
+    explicit conversion_cache(std::size_t capacity = 4096)
+        : slots_(new slot[detail::shard_count(capacity)]), mask_(detail::shard_count(capacity) - 1)
+    {
+    }
+
+    conversion_cache(const conversion_cache&) = delete;
+    conversion_cache& operator=(const conversion_cache&) = delete;
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_.value.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] std::optional<double> find(unit_id from, unit_id to) const noexcept
+    {
+      const std::uint64_t key = make_key(from, to);
+      const std::size_t first = home(key);
+      for (std::size_t i = 0; i < max_probe; ++i) {
+        const slot& s = slots_[(first + i) & mask_];
+        const std::uint64_t current = s.key.load(std::memory_order_acquire);
+        if (current == key) return s.factor.load(std::memory_order_relaxed);
+        if (current == 0) break;
+      }
+      return std::nullopt;
+    }
+
+    // factor of the pair if cached, otherwise the result of compute(from, to) stored in the cache
+    template<typename F>
+    double get_or_compute(unit_id from, unit_id to, F&& compute)
+    {
+      if (const auto cached = find(from, to)) return *cached;
+      const double factor = compute(from, to);
+      insert(make_key(from, to), factor);
+      return factor;
+    }
+
+    // factor converting values of the `from` unit to the `to` unit; throws dimension_mismatch
+    double factor(unit_id from, unit_id to)
+    {
+      return get_or_compute(from, to, [](unit_id f, unit_id t) { return Registry::conversion_factor(f, t); });
+    }
+  };
+
+}  // namespace units
@@ -0,0 +1,277 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/charconv.h>
+#include <units/bits/concurrency.h>
+#include <units/parse.h>
+#include <units/quantity_soa.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace units {
+
+  struct csv_options {
+    char delimiter = ',';                                          // ',' for CSV, '\t' for TSV
+    std::size_t threads = std::thread::hardware_concurrency();     // parsing threads
+    std::size_t block_size = std::size_t(16) << 20;                // bytes read from the stream at once
+  };
+
+  namespace detail {
+
+    // type of the numbers parsed from the text before they are converted to the rep of Q
+    template<Quantity Q>
+    using csv_number = conditional<treat_as_floating_point<typename Q::rep>,
+                                   std::common_type_t<typename Q::rep, double>, std::intmax_t>;
+
+    [[nodiscard]] constexpr std::string_view csv_trim(std::string_view s) noexcept
+    {
+      while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+      while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+      return s;
+    }
+
+    // Splits "name[unit]" into its name and unit parts
+    [[nodiscard]] constexpr std::pair<std::string_view, std::string_view> csv_split_header_field(std::string_view field)
+    {
+      field = csv_trim(field);
+      const auto open = field.find('[');
+      if (open == std::string_view::npos || field.back() != ']') return {field, {}};
+      return {csv_trim(field.substr(0, open)), csv_trim(field.substr(open + 1, field.size() - open - 2))};
+    }
+
+    template<Quantity... Qs>
+    class csv_reader {
+      static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+      using raw_columns = std::tuple<std::vector<csv_number<Qs>>...>;
+
+      char delimiter_;
+      std::vector<std::size_t> selection_;  // index of the requested column for every field of a row (or npos)
+      std::array<unit_conversion, sizeof...(Qs)> conversions_;
+
+    public:
+      csv_reader(std::string_view header, const std::array<std::string_view, sizeof...(Qs)>& names, char delimiter) :
+          delimiter_(delimiter)
+      {
+        std::array<bool, sizeof...(Qs)> found{};
+        for (std::size_t field = 0; !header.empty() || field == 0; ++field) {
+          const auto end = header.find(delimiter_);
+          const auto [name, unit] = csv_split_header_field(header.substr(0, end));
+          header = end == std::string_view::npos ? std::string_view() : header.substr(end + 1);
+          selection_.push_back(npos);
+          for (std::size_t i = 0; i < names.size(); ++i) {
+            if (name != names[i]) continue;
+            if (found[i]) throw std::runtime_error("units::load_csv: duplicated column '" + std::string(name) + "'");
+            if (unit.empty())
+              throw std::runtime_error("units::load_csv: no unit for column '" + std::string(name) + "'");
+            conversions_[i] = find_conversion(i, unit, std::index_sequence_for<Qs...>());
+            selection_.back() = i;
+            found[i] = true;
+          }
+          if (end == std::string_view::npos) break;
+        }
+        for (std::size_t i = 0; i < names.size(); ++i)
+          if (!found[i]) throw std::runtime_error("units::load_csv: column '" + std::string(names[i]) + "' not found");
+      }
+
+      // Parses complete lines of [first, last) and appends converted values to out
+      void parse(const char* first, const char* last, quantity_soa<Qs...>& out, std::size_t threads) const
+      {
+        // chunk boundaries are realigned to the beginning of the next line (a boundary at `first`
+        // already is one; blocks shorter than the number of chunks give empty chunks)
+        std::vector<const char*> bounds{first};
+        const std::size_t chunks = std::max<std::size_t>(threads, 1);
+        for (std::size_t c = 1; c < chunks; ++c) {
+          const char* p = std::max(bounds.back(), first + (last - first) * static_cast<std::ptrdiff_t>(c) /
+                                                              static_cast<std::ptrdiff_t>(chunks));
+          while (p != first && p != last && p[-1] != '\n') ++p;
+          bounds.push_back(p);
+        }
+        bounds.push_back(last);
+
+        std::vector<raw_columns> raw(chunks);
+        std::vector<std::exception_ptr> errors(chunks);
+        parallel_for(0, chunks, threads, [&](std::size_t first_chunk, std::size_t last_chunk) {
+          for (std::size_t c = first_chunk; c < last_chunk; ++c) {
+            try {
+              parse_chunk(bounds[c], bounds[c + 1], raw[c]);
+            }
+            catch (...) {
+              errors[c] = std::current_exception();
+            }
+          }
+        });
+        for (auto& e : errors)
+          if (e) std::rethrow_exception(e);
+
+        for (auto& r : raw) append(r, out, std::index_sequence_for<Qs...>());
+      }
+
+    private:
+      template<std::size_t... Is>
+      static unit_conversion find_conversion(std::size_t i, std::string_view unit, std::index_sequence<Is...>)
+      {
+        const unit_conversion* result = nullptr;
+        ((i == Is ? (void)(result = unit_symbol_table<typename Qs::unit>::find(unit)) : void()), ...);
+        if (result == nullptr)
+          throw std::runtime_error("units::load_csv: unit '" + std::string(unit) +
+                                   "' unknown or not convertible to the requested quantity");
+        return *result;
+      }
+
+      template<std::size_t I>
+      static void parse_value(std::string_view field, raw_columns& raw)
+      {
+        field = csv_trim(field);
+        csv_number<std::tuple_element_t<I, std::tuple<Qs...>>> value{};
+        const auto [ptr, ec] = detail::number_from_chars(field.data(), field.data() + field.size(), value);
+        if (ec != std::errc() || ptr != field.data() + field.size())
+          throw std::runtime_error("units::load_csv: invalid value '" + std::string(field) + "'");
+        std::get<I>(raw).push_back(value);
+      }
+
+      template<std::size_t... Is>
+      void parse_field(std::size_t column, std::string_view field, raw_columns& raw, std::index_sequence<Is...>) const
+      {
+        ((column == Is ? parse_value<Is>(field, raw) : void()), ...);
+      }
+
+      void parse_chunk(const char* first, const char* last, raw_columns& raw) const
+      {
+        while (first != last) {
+          const char* eol = std::find(first, last, '\n');
+          const std::string_view row(first, static_cast<std::size_t>(eol - first));
+          first = eol == last ? last : eol + 1;
+          if (csv_trim(row).empty()) continue;
+
+          std::string_view line = row;
+          std::size_t parsed = 0;
+          for (std::size_t field = 0; field < selection_.size(); ++field) {
+            const auto end = line.find(delimiter_);
+            if (selection_[field] != npos) {
+              parse_field(selection_[field], line.substr(0, end), raw, std::index_sequence_for<Qs...>());
+              ++parsed;
+            }
+            if (end == std::string_view::npos) break;
+            line.remove_prefix(end + 1);
+          }
+          if (parsed != sizeof...(Qs))
+            throw std::runtime_error("units::load_csv: missing fields in line '" + std::string(csv_trim(row)) + "'");
+        }
+      }
+
+      // converts raw numbers of every column with a factor resolved once per column
+      template<std::size_t... Is>
+      void append(const raw_columns& raw, quantity_soa<Qs...>& out, std::index_sequence<Is...>) const
+      {
+        const std::size_t offset = out.size();
+        out.resize(offset + std::get<0>(raw).size());
+        (append_column<Is>(std::get<Is>(raw), out.template column<Is>().subspan(offset, std::get<Is>(raw).size())),
+         ...);
+      }
+
+      template<std::size_t I, typename Number, typename Q>
+      void append_column(const std::vector<Number>& raw, quantity_span<Q> out) const
+      {
+        using rep = Q::rep;
+        const unit_conversion& c = conversions_[I];
+        const std::size_t n = raw.size();
+        Q* o = out.data();
+        if constexpr (treat_as_floating_point<rep>) {
+          // the ratio is folded into one factor (the result may differ from from_chars in the last bit)
+          const Number factor = static_cast<Number>(c.num) / static_cast<Number>(c.den);
+          if (c.den == 1 && c.num == 1)
+            for (std::size_t i = 0; i < n; ++i) o[i] = Q(static_cast<rep>(raw[i]));
+          else
+            for (std::size_t i = 0; i < n; ++i) o[i] = Q(static_cast<rep>(raw[i] * factor));
+        }
+        else {
+          for (std::size_t i = 0; i < n; ++i)
+            if (convert_parsed(raw[i], c, o[i]) != std::errc())
+              throw std::runtime_error("units::load_csv: value '" + std::to_string(raw[i]) + "' in unit '" +
+                                       std::string(c.symbol) + "' is not representable in the requested quantity");
+        }
+      }
+    };
+
+  }  // namespace detail
+
+  // load_csv
+  //
+  // Loads the columns `names` of a CSV/TSV stream into a struct-of-arrays container. The header
+  // line has to describe the unit of every loaded column as "name[unit]" (i.e. "speed[km/h]").
+  // The unit has to be convertible to the requested quantity type; the conversion factor is resolved
+  // once per column and applied to whole columns of parsed numbers. The stream is read in blocks
+  // and every block is parsed by several threads in chunks realigned to line boundaries.
+  // Quoted fields are not supported. Throws std::runtime_error on malformed input and on values that
+  // an integral quantity cannot represent exactly in its unit.
+
+  template<Quantity... Qs>
+  [[nodiscard]] quantity_soa<Qs...> load_csv(std::istream& is, const std::array<std::string_view, sizeof...(Qs)>& names,
+                                             const csv_options& options = csv_options())
+  {
+    std::string header;
+    if (!std::getline(is, header)) throw std::runtime_error("units::load_csv: missing header");
+    const detail::csv_reader<Qs...> reader(header, names, options.delimiter);
+
+    quantity_soa<Qs...> result;
+    std::string block;
+    std::size_t carry = 0;  // bytes of an incomplete line moved from the previous block
+    while (is) {
+      block.resize(carry + options.block_size);
+      is.read(block.data() + carry, static_cast<std::streamsize>(options.block_size));
+      const std::size_t size = carry + static_cast<std::size_t>(is.gcount());
+      const std::size_t complete = is ? block.rfind('\n', size - 1) + 1 : size;
+      reader.parse(block.data(), block.data() + complete, result, options.threads);
+      carry = size - complete;
+      std::copy(block.data() + complete, block.data() + size, block.data());
+    }
+    if (is.bad()) throw std::runtime_error("units::load_csv: read error");
+    return result;
+  }
+
+  template<Quantity... Qs>
+  [[nodiscard]] quantity_soa<Qs...> load_csv(const std::string& path,
+                                             const std::array<std::string_view, sizeof...(Qs)>& names,
+                                             const csv_options& options = csv_options())
+  {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw std::runtime_error("units::load_csv: cannot open '" + path + "'");
+    return load_csv<Qs...>(file, names, options);
+  }
+
+}  // namespace units
@@ -38,6 +38,8 @@ namespace units {
 
   struct ampere : unit<dimension_current> {};
   template<> struct upcasting_traits<upcast_from<ampere>> : upcast_to<ampere> {};
+  template<> inline constexpr std::string_view unit_symbol<ampere> = "A";
+  UNITS_EXTERN_QUANTITY(ampere);
 
   inline namespace literals {
 
@@ -162,7 +162,11 @@ namespace units {
 
   template<Dimension D1, Dimension D2>
   struct merge_dimension {
-    using type = type_list_sort<detail::dim_consolidate_t<type_list_merge_sorted<D1, D2, exp_dim_id_less>>, exp_greater_equal>;
+    // dimensions are sorted by exponents so they have to be sorted by ids before the merge
+    using type = type_list_sort<detail::dim_consolidate_t<type_list_merge_sorted<type_list_sort<D1, exp_dim_id_less>,
+                                                                                 type_list_sort<D2, exp_dim_id_less>,
+                                                                                 exp_dim_id_less>>,
+                                exp_greater_equal>;
   };
 
   template<Dimension D1, Dimension D2>
@@ -192,4 +196,20 @@ namespace units {
   template<Dimension D1, Dimension D2>
   using dimension_divide_t = dimension_divide<typename D1::base_type, typename D2::base_type>::type;
 
+  // dimension_exponent
+
+  namespace detail {
+
+    template<typename BaseDimension, Dimension D>
+    inline constexpr int dimension_exponent_impl = 0;
+
+    template<typename BaseDimension, Exponent... Es>
+    inline constexpr int dimension_exponent_impl<BaseDimension, dimension<Es...>> =
+        ((std::is_same_v<typename Es::dimension, BaseDimension> ? Es::value : 0) + ... + 0);
+
+  }  // namespace detail
+
+  template<Dimension D, typename BaseDimension>
+  inline constexpr int dimension_exponent = detail::dimension_exponent_impl<BaseDimension, typename D::base_type>;
+
 }  // namespace units
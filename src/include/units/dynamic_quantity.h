@@ -0,0 +1,266 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/base_dimensions.h>
+#include <units/quantity.h>
+#include <cstdint>
+#include <stdexcept>
+
+namespace units {
+
+  // packed_dimension
+  //
+  // Exponents of all the base dimensions packed into one 64-bit word: an 8-bit two's complement
+  // lane per base dimension id. Dimension checks are a single integer compare and multiplication
+  // and division of dimensions are lane-wise (SWAR) additions and subtractions.
+
+  class packed_dimension {
+    static constexpr std::uint64_t high_bits = 0x8080'8080'8080'8080;
+
+    std::uint64_t bits_ = 0;
+
+    constexpr explicit packed_dimension(std::uint64_t bits) noexcept : bits_(bits) {}
+
+    template<Exponent... Es>
+    static constexpr std::uint64_t pack(dimension<Es...>) noexcept
+    {
+      return ((static_cast<std::uint64_t>(static_cast<std::uint8_t>(Es::value)) << (8 * Es::dimension::value)) | ... |
+              std::uint64_t(0));
+    }
+
+  public:
+    static constexpr std::size_t max_base_dimensions = 8;
+
+    constexpr packed_dimension() noexcept = default;  // dimensionless
+
+    template<Dimension D>
+    [[nodiscard]] static constexpr packed_dimension of() noexcept
+    {
+      return packed_dimension(pack(typename D::base_type()));
+    }
+
+    [[nodiscard]] static constexpr packed_dimension from_raw(std::uint64_t bits) noexcept
+    {
+      return packed_dimension(bits);
+    }
+
+    [[nodiscard]] constexpr std::uint64_t raw() const noexcept { return bits_; }
+    [[nodiscard]] constexpr bool dimensionless() const noexcept { return bits_ == 0; }
+
+    [[nodiscard]] constexpr int exponent(std::size_t base_dim_id) const
+    {
+      Expects(base_dim_id < max_base_dimensions);
+      return static_cast<std::int8_t>(static_cast<std::uint8_t>(bits_ >> (8 * base_dim_id)));
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(packed_dimension lhs, packed_dimension rhs) noexcept
+    {
+      return lhs.bits_ == rhs.bits_;
+    }
+
+    [[nodiscard]] friend constexpr bool operator!=(packed_dimension lhs, packed_dimension rhs) noexcept
+    {
+      return !(lhs == rhs);
+    }
+
+    [[nodiscard]] friend constexpr packed_dimension operator*(packed_dimension lhs, packed_dimension rhs) noexcept
+    {
+      const std::uint64_t a = lhs.bits_, b = rhs.bits_;
+      return packed_dimension(((a & ~high_bits) + (b & ~high_bits)) ^ ((a ^ b) & high_bits));
+    }
+
+    [[nodiscard]] friend constexpr packed_dimension operator/(packed_dimension lhs, packed_dimension rhs) noexcept
+    {
+      const std::uint64_t a = lhs.bits_, b = rhs.bits_;
+      return packed_dimension(((a | high_bits) - (b & ~high_bits)) ^ ((a ^ ~b) & high_bits));
+    }
+
+    [[nodiscard]] constexpr packed_dimension inverse() const noexcept { return packed_dimension() / *this; }
+  };
+
+  // dimension_mismatch
+
+  class dimension_mismatch : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  // dynamic_quantity
+  //
+  // Quantity with the dimension and the unit known only at runtime. The unit is described by its
+  // magnitude, i.e. the ratio to the coherent unit of the dimension (1000 for a kilometer).
+  // Operations requiring the same dimension throw dimension_mismatch.
+
+  class dynamic_quantity {
+    double value_ = 0;
+    double magnitude_ = 1;
+    packed_dimension dimension_;
+
+    static constexpr void check_same_dimension(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+    {
+      if (lhs.dimension_ != rhs.dimension_) throw dimension_mismatch("units::dynamic_quantity: dimension mismatch");
+    }
+
+  public:
+    constexpr dynamic_quantity() noexcept = default;
+    constexpr dynamic_quantity(double value, packed_dimension dimension, double magnitude = 1) noexcept :
+        value_(value), magnitude_(magnitude), dimension_(dimension)
+    {
+    }
+
+    // explicit so that a static quantity never silently takes the runtime-checked paths
+    template<Dimension D, Unit U, Scalar Rep>
+    constexpr explicit dynamic_quantity(const quantity<D, U, Rep>& q) noexcept :
+        value_(static_cast<double>(q.count())),
+        magnitude_(static_cast<double>(U::ratio::num) / static_cast<double>(U::ratio::den)),
+        dimension_(packed_dimension::of<D>())
+    {
+    }
+
+    [[nodiscard]] constexpr double value() const noexcept { return value_; }
+    [[nodiscard]] constexpr double magnitude() const noexcept { return magnitude_; }
+    [[nodiscard]] constexpr packed_dimension dimension() const noexcept { return dimension_; }
+
+    // value in the coherent unit of the dimension
+    [[nodiscard]] constexpr double coherent_value() const noexcept { return value_ * magnitude_; }
+
+    // value expressed in a unit of the given magnitude
+    [[nodiscard]] constexpr double value_in(double magnitude) const noexcept
+    {
+      return magnitude == magnitude_ ? value_ : value_ * magnitude_ / magnitude;
+    }
+
+    [[nodiscard]] constexpr dynamic_quantity operator-() const noexcept
+    {
+      return dynamic_quantity(-value_, dimension_, magnitude_);
+    }
+
+    constexpr dynamic_quantity& operator+=(const dynamic_quantity& q)
+    {
+      check_same_dimension(*this, q);
+      value_ += q.value_in(magnitude_);
+      return *this;
+    }
+
+    constexpr dynamic_quantity& operator-=(const dynamic_quantity& q)
+    {
+      check_same_dimension(*this, q);
+      value_ -= q.value_in(magnitude_);
+      return *this;
+    }
+
+    constexpr dynamic_quantity& operator*=(double v) noexcept
+    {
+      value_ *= v;
+      return *this;
+    }
+
+    constexpr dynamic_quantity& operator/=(double v) noexcept
+    {
+      value_ /= v;
+      return *this;
+    }
+
+    [[nodiscard]] friend constexpr dynamic_quantity operator+(dynamic_quantity lhs, const dynamic_quantity& rhs)
+    {
+      return lhs += rhs;
+    }
+
+    [[nodiscard]] friend constexpr dynamic_quantity operator-(dynamic_quantity lhs, const dynamic_quantity& rhs)
+    {
+      return lhs -= rhs;
+    }
+
+    [[nodiscard]] friend constexpr dynamic_quantity operator*(const dynamic_quantity& lhs,
+                                                              const dynamic_quantity& rhs) noexcept
+    {
+      return dynamic_quantity(lhs.value_ * rhs.value_, lhs.dimension_ * rhs.dimension_,
+                              lhs.magnitude_ * rhs.magnitude_);
+    }
+
+    [[nodiscard]] friend constexpr dynamic_quantity operator/(const dynamic_quantity& lhs,
+                                                              const dynamic_quantity& rhs) noexcept
+    {
+      return dynamic_quantity(lhs.value_ / rhs.value_, lhs.dimension_ / rhs.dimension_,
+                              lhs.magnitude_ / rhs.magnitude_);
+    }
+
+    [[nodiscard]] friend constexpr dynamic_quantity operator*(dynamic_quantity q, double v) noexcept { return q *= v; }
+    [[nodiscard]] friend constexpr dynamic_quantity operator*(double v, dynamic_quantity q) noexcept { return q *= v; }
+    [[nodiscard]] friend constexpr dynamic_quantity operator/(dynamic_quantity q, double v) noexcept { return q /= v; }
+
+    [[nodiscard]] friend constexpr dynamic_quantity operator/(double v, const dynamic_quantity& q) noexcept
+    {
+      return dynamic_quantity(v / q.value_, q.dimension_.inverse(), 1 / q.magnitude_);
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+    {
+      check_same_dimension(lhs, rhs);
+      return lhs.value_ == rhs.value_in(lhs.magnitude_);
+    }
+
+    [[nodiscard]] friend constexpr bool operator!=(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+    {
+      return !(lhs == rhs);
+    }
+
+    [[nodiscard]] friend constexpr bool operator<(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+    {
+      check_same_dimension(lhs, rhs);
+      return lhs.value_ < rhs.value_in(lhs.magnitude_);
+    }
+
+    [[nodiscard]] friend constexpr bool operator>(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+    {
+      return rhs < lhs;
+    }
+
+    [[nodiscard]] friend constexpr bool operator<=(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+    {
+      return !(rhs < lhs);
+    }
+
+    [[nodiscard]] friend constexpr bool operator>=(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+    {
+      return !(lhs < rhs);
+    }
+  };
+
+  // quantity_cast
+  //
+  // Checked conversion of a dynamic quantity to a static one. Throws dimension_mismatch if the
+  // dimension of the dynamic quantity differs from the one of To.
+
+  template<Quantity To>
+  [[nodiscard]] constexpr To quantity_cast(const dynamic_quantity& q)
+  {
+    if (q.dimension() != packed_dimension::of<typename To::dimension>())
+      throw dimension_mismatch("units::quantity_cast: dimension mismatch");
+    using r = To::unit::ratio;
+    return To(static_cast<typename To::rep>(q.value_in(static_cast<double>(r::num) / static_cast<double>(r::den))));
+  }
+
+}  // namespace units
@@ -0,0 +1,462 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/unit_registry.h>
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace units {
+
+  // expression_error
+  //
+  // Syntax error in the source of an expression. Dimension errors throw dimension_mismatch.
+
+  class expression_error : public std::runtime_error {
+    std::size_t position_;
+
+  public:
+    expression_error(const std::string& what, std::size_t position) :
+        std::runtime_error(what + " at position " + std::to_string(position)), position_(position)
+    {
+    }
+
+    [[nodiscard]] std::size_t position() const noexcept { return position_; }
+  };
+
+  // expression_variable
+  //
+  // Name of a variable of an expression and the unit of its values.
+
+  struct expression_variable {
+    std::string_view name;
+    unit_id unit;
+  };
+
+  // expression_op
+  //
+  // Every operation pushes its result or replaces the operands on the top of the stack with it, and
+  // multiplies the result by `scale`. The right operand of a binary operation is either popped from
+  // the stack or read directly from a column or a constant.
+
+  enum class expression_op_code : std::uint8_t {
+    load,      // push column[index]
+    constant,  // push constant
+    add,
+    subtract,
+    multiply,
+    divide
+  };
+
+  enum class expression_operand : std::uint8_t { stack, column, constant };
+
+  struct expression_op {
+    expression_op_code code;
+    expression_operand operand = expression_operand::stack;
+    std::uint32_t index = 0;
+    double constant = 0;
+    double scale = 1;
+  };
+
+  // compiled_expression
+  //
+  // Flat stack machine program produced by compile_expression(). Dimensions are checked and all the
+  // unit conversions are folded into constants at compile time of the expression, so evaluation
+  // only does arithmetic on batches of raw values.
+
+  class compiled_expression {
+  public:
+    static constexpr std::size_t batch_size = 256;
+
+  private:
+    std::vector<expression_op> ops_;
+    std::size_t variables_ = 0;
+    std::size_t max_depth_ = 0;
+    packed_dimension dimension_;
+
+    template<typename Registry>
+    friend class expression_compiler;
+
+    template<typename F>
+    static void apply(double* r, const double* b, std::size_t n, double scale, F f)
+    {
+      for (std::size_t i = 0; i < n; ++i) r[i] = f(r[i], b[i]) * scale;
+    }
+
+    template<typename F>
+    static void apply(double* r, double b, std::size_t n, double scale, F f)
+    {
+      for (std::size_t i = 0; i < n; ++i) r[i] = f(r[i], b) * scale;
+    }
+
+    // scratch stack of the calling thread, grown on demand and reused by all the expressions
+    [[nodiscard]] double* thread_stack() const
+    {
+      thread_local std::vector<double> stack;
+      if (stack.size() < scratch_size()) stack.resize(scratch_size());
+      return stack.data();
+    }
+
+    void run(const double* const* columns, std::size_t first, std::size_t n, double* stack, double* out) const
+    {
+      std::size_t top = 0;  // number of occupied stack slots
+      auto slot = [&](std::size_t i) { return i == 0 ? out : stack + (i - 1) * batch_size; };
+      auto binary = [&](const expression_op& op, auto f) {
+        switch (op.operand) {
+          case expression_operand::stack: {
+            const double* b = slot(--top);
+            apply(slot(top - 1), b, n, op.scale, f);
+            break;
+          }
+          case expression_operand::column: apply(slot(top - 1), columns[op.index] + first, n, op.scale, f); break;
+          case expression_operand::constant: apply(slot(top - 1), op.constant, n, op.scale, f); break;
+        }
+      };
+      for (const expression_op& op : ops_) {
+        switch (op.code) {
+          case expression_op_code::load: {
+            double* r = slot(top++);
+            const double* in = columns[op.index] + first;
+            const double scale = op.scale;
+            for (std::size_t i = 0; i < n; ++i) r[i] = in[i] * scale;
+            break;
+          }
+          case expression_op_code::constant: std::fill_n(slot(top++), n, op.constant * op.scale); break;
+          case expression_op_code::add: binary(op, [](double a, double b) { return a + b; }); break;
+          case expression_op_code::subtract: binary(op, [](double a, double b) { return a - b; }); break;
+          case expression_op_code::multiply: binary(op, [](double a, double b) { return a * b; }); break;
+          case expression_op_code::divide: binary(op, [](double a, double b) { return a / b; }); break;
+        }
+      }
+    }
+
+  public:
+    [[nodiscard]] const std::vector<expression_op>& ops() const noexcept { return ops_; }
+    [[nodiscard]] std::size_t variables() const noexcept { return variables_; }
+
+    // dimension of the result
+    [[nodiscard]] packed_dimension dimension() const noexcept { return dimension_; }
+
+    // number of doubles of the scratch stack needed by evaluate()
+    [[nodiscard]] std::size_t scratch_size() const noexcept
+    {
+      return max_depth_ > 1 ? (max_depth_ - 1) * batch_size : 0;  // the bottom of the stack is the output
+    }
+
+    // Evaluates the expression for `rows` rows. columns[i] points to the values of the i-th variable
+    // expressed in its unit; the results are written to `out` which must not overlap the columns.
+    // `scratch` provides scratch_size() doubles for the intermediate results.
+    void evaluate(const double* const* columns, std::size_t rows, double* out, double* scratch) const
+    {
+      for (std::size_t first = 0; first < rows; first += batch_size)
+        run(columns, first, std::min(batch_size, rows - first), scratch, out + first);
+    }
+
+    // as above with a scratch stack kept by the calling thread between the calls
+    void evaluate(const double* const* columns, std::size_t rows, double* out) const
+    {
+      evaluate(columns, rows, out, thread_stack());
+    }
+
+    [[nodiscard]] std::vector<double> evaluate(const std::vector<const double*>& columns, std::size_t rows) const
+    {
+      Expects(columns.size() == variables_);
+      std::vector<double> result(rows);
+      evaluate(columns.data(), rows, result.data());
+      return result;
+    }
+
+    // value for a single row of values
+    [[nodiscard]] double operator()(const std::vector<double>& values) const
+    {
+      Expects(values.size() == variables_);
+      // a single row is stored as consecutive one-element columns
+      thread_local std::vector<const double*> columns;
+      columns.resize(values.size());
+      for (std::size_t i = 0; i < values.size(); ++i) columns[i] = &values[i];
+      double result = 0;
+      evaluate(columns.data(), 1, &result);
+      return result;
+    }
+  };
+
+  // expression_compiler
+  //
+  // Recursive descent parser of the grammar:
+  //
+  //   expr    := term (('+' | '-') term)*
+  //   term    := unary (('*' | '/') unary)*
+  //   unary   := '-' unary | primary
+  //   primary := number ['[' unit symbol ']'] | variable | '(' expr ')'
+  //
+  // Every value on the stack is kept in some unit of its dimension; the magnitude of that unit is
+  // tracked by the compiler only. Products and quotients combine the magnitudes for free, sums scale
+  // the right operand to the unit of the left one and the result is finally scaled to the requested
+  // unit. Scales (including negations) are folded into the preceding operation, operations on
+  // constants are evaluated and constant or variable right operands are read in place.
+
+  template<typename Registry = unit_registry>
+  class expression_compiler {
+    struct operand {
+      packed_dimension dimension;
+      double magnitude;
+    };
+
+    std::string_view source_;
+    std::size_t pos_ = 0;
+    const std::vector<expression_variable>& variables_;
+    compiled_expression result_;
+    std::size_t depth_ = 0;
+
+    [[noreturn]] void fail(const char* what) const { throw expression_error(what, pos_); }
+
+    void skip_spaces()
+    {
+      while (pos_ < source_.size() && (source_[pos_] == ' ' || source_[pos_] == '\t')) ++pos_;
+    }
+
+    bool consume(char c)
+    {
+      skip_spaces();
+      if (pos_ < source_.size() && source_[pos_] == c) {
+        ++pos_;
+        return true;
+      }
+      return false;
+    }
+
+    [[nodiscard]] static constexpr bool is_digit(char c) { return c >= '0' && c <= '9'; }
+    [[nodiscard]] static constexpr bool is_alpha(char c)
+    {
+      return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+
+    void push(const expression_op& op)
+    {
+      std::vector<expression_op>& ops = result_.ops_;
+      if (op.code == expression_op_code::load || op.code == expression_op_code::constant) {
+        result_.max_depth_ = std::max(result_.max_depth_, ++depth_);
+        ops.push_back(op);
+        return;
+      }
+
+      // binary operation
+      --depth_;
+      expression_op& rhs = ops.back();
+      if (rhs.code == expression_op_code::constant) {
+        const double b = rhs.constant;
+        ops.pop_back();
+        if (ops.back().code == expression_op_code::constant) {
+          double& a = ops.back().constant;
+          switch (op.code) {
+            case expression_op_code::add: a += b; break;
+            case expression_op_code::subtract: a -= b; break;
+            case expression_op_code::multiply: a *= b; break;
+            default: a /= b; break;
+          }
+        }
+        else if (op.code == expression_op_code::multiply)
+          scale(b);
+        else
+          ops.push_back({op.code, expression_operand::constant, 0, b});
+      }
+      else if (rhs.code == expression_op_code::load &&
+               (rhs.scale == 1 || op.code == expression_op_code::multiply || op.code == expression_op_code::divide)) {
+        // a * (s * b) == (a * b) * s and a / (s * b) == (a / b) / s
+        const double s = op.code == expression_op_code::divide ? 1 / rhs.scale : rhs.scale;
+        rhs = {op.code, expression_operand::column, rhs.index, 0, s};
+      }
+      else
+        ops.push_back(op);
+    }
+
+    // multiplies the top of the stack by the factor
+    void scale(double factor)
+    {
+      expression_op& last = result_.ops_.back();
+      if (last.code == expression_op_code::constant)
+        last.constant *= factor;
+      else
+        last.scale *= factor;
+    }
+
+    double number()
+    {
+      std::uint64_t mantissa = 0;
+      int exponent = 0;
+      bool digits = false;
+      for (; pos_ < source_.size() && is_digit(source_[pos_]); ++pos_, digits = true) {
+        if (mantissa < 100'000'000'000'000'000)
+          mantissa = mantissa * 10 + static_cast<std::uint64_t>(source_[pos_] - '0');
+        else
+          ++exponent;
+      }
+      if (pos_ < source_.size() && source_[pos_] == '.') {
+        for (++pos_; pos_ < source_.size() && is_digit(source_[pos_]); ++pos_, digits = true) {
+          if (mantissa < 100'000'000'000'000'000) {
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(source_[pos_] - '0');
+            --exponent;
+          }
+        }
+      }
+      if (!digits) fail("units::compile_expression: invalid number");
+      if (pos_ < source_.size() && (source_[pos_] == 'e' || source_[pos_] == 'E')) {
+        ++pos_;
+        const bool negative = pos_ < source_.size() && source_[pos_] == '-';
+        if (pos_ < source_.size() && (source_[pos_] == '-' || source_[pos_] == '+')) ++pos_;
+        if (pos_ == source_.size() || !is_digit(source_[pos_])) fail("units::compile_expression: invalid exponent");
+        int e = 0;
+        for (; pos_ < source_.size() && is_digit(source_[pos_]); ++pos_)
+          e = std::min(e * 10 + (source_[pos_] - '0'), 9999);
+        exponent += negative ? -e : e;
+      }
+      double power = 1;
+      for (int i = 0; i < (exponent < 0 ? -exponent : exponent); ++i) power *= 10;
+      return exponent < 0 ? static_cast<double>(mantissa) / power : static_cast<double>(mantissa) * power;
+    }
+
+    operand primary()
+    {
+      skip_spaces();
+      if (consume('(')) {
+        const operand r = expr();
+        if (!consume(')')) fail("units::compile_expression: expected ')'");
+        return r;
+      }
+      if (pos_ < source_.size() && (is_digit(source_[pos_]) || source_[pos_] == '.')) {
+        push({expression_op_code::constant, expression_operand::stack, 0, number()});
+        if (!consume('[')) return {packed_dimension(), 1};
+        const std::size_t end = source_.find(']', pos_);
+        if (end == std::string_view::npos) fail("units::compile_expression: expected ']'");
+        const auto id = Registry::find(source_.substr(pos_, end - pos_));
+        if (!id) fail("units::compile_expression: unknown unit");
+        pos_ = end + 1;
+        return {Registry::dimensions[*id], Registry::magnitudes[*id]};
+      }
+      if (pos_ < source_.size() && is_alpha(source_[pos_])) {
+        const std::size_t first = pos_;
+        while (pos_ < source_.size() && (is_alpha(source_[pos_]) || is_digit(source_[pos_]))) ++pos_;
+        const std::string_view name = source_.substr(first, pos_ - first);
+        for (std::size_t i = 0; i < variables_.size(); ++i) {
+          if (variables_[i].name == name) {
+            push({expression_op_code::load, expression_operand::column, static_cast<std::uint32_t>(i)});
+            const unit_id id = variables_[i].unit;
+            return {Registry::dimensions[id], Registry::magnitudes[id]};
+          }
+        }
+        pos_ = first;
+        fail("units::compile_expression: unknown variable");
+      }
+      fail("units::compile_expression: expected a number, a variable or '('");
+    }
+
+    operand unary()
+    {
+      if (consume('-')) {
+        const operand r = unary();
+        scale(-1);
+        return r;
+      }
+      return primary();
+    }
+
+    operand term()
+    {
+      operand lhs = unary();
+      for (;;) {
+        if (consume('*')) {
+          const operand rhs = unary();
+          push({expression_op_code::multiply});
+          lhs = {lhs.dimension * rhs.dimension, lhs.magnitude * rhs.magnitude};
+        }
+        else if (consume('/')) {
+          const operand rhs = unary();
+          push({expression_op_code::divide});
+          lhs = {lhs.dimension / rhs.dimension, lhs.magnitude / rhs.magnitude};
+        }
+        else
+          return lhs;
+      }
+    }
+
+    operand expr()
+    {
+      const operand lhs = term();
+      for (;;) {
+        const std::size_t op_pos = pos_;
+        const bool plus = consume('+');
+        if (!plus && !consume('-')) return lhs;
+        const operand rhs = term();
+        if (rhs.dimension != lhs.dimension)
+          throw dimension_mismatch("units::compile_expression: operands of different dimensions at position " +
+                                   std::to_string(op_pos));
+        scale(rhs.magnitude / lhs.magnitude);
+        push({plus ? expression_op_code::add : expression_op_code::subtract});
+      }
+    }
+
+  public:
+    expression_compiler(std::string_view source, const std::vector<expression_variable>& variables) :
+        source_(source), variables_(variables)
+    {
+      for (const expression_variable& v : variables) Expects(v.unit < Registry::size);
+      result_.variables_ = variables.size();
+    }
+
+    // Compiles the expression with the result expressed in the given unit or in the coherent unit
+    // of its dimension if none is given.
+    [[nodiscard]] compiled_expression compile(std::optional<unit_id> result_unit = std::nullopt) &&
+    {
+      const operand r = expr();
+      skip_spaces();
+      if (pos_ != source_.size()) fail("units::compile_expression: unexpected character");
+      double magnitude = 1;
+      if (result_unit) {
+        Expects(*result_unit < Registry::size);
+        if (Registry::dimensions[*result_unit] != r.dimension)
+          throw dimension_mismatch("units::compile_expression: result is not convertible to the requested unit");
+        magnitude = Registry::magnitudes[*result_unit];
+      }
+      scale(r.magnitude / magnitude);
+      result_.dimension_ = r.dimension;
+      return std::move(result_);
+    }
+  };
+
+  // compile_expression
+
+  template<typename Registry = unit_registry>
+  [[nodiscard]] compiled_expression compile_expression(std::string_view source,
+                                                       const std::vector<expression_variable>& variables,
+                                                       std::optional<unit_id> result_unit = std::nullopt)
+  {
+    return expression_compiler<Registry>(source, variables).compile(result_unit);
+  }
+
+}  // namespace units
@@ -0,0 +1,252 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/base_dimensions.h>
+#include <units/bits/charconv.h>
+#include <units/quantity.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <ostream>
+#include <ratio>
+#include <string_view>
+#include <system_error>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+namespace units {
+
+  namespace detail {
+
+    // Fixed capacity string built at compile time
+    template<std::size_t N>
+    struct symbol_buffer {
+      char data[N]{};
+      std::size_t size = 0;
+
+      constexpr void append(std::string_view s)
+      {
+        for (char c : s) data[size++] = c;
+      }
+
+      constexpr void append(std::intmax_t v, bool superscript = false)
+      {
+        constexpr std::string_view digits[] = {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"};
+        constexpr std::string_view superscript_digits[] = {"⁰", "¹", "²", "³", "⁴", "⁵", "⁶", "⁷", "⁸", "⁹"};
+        if (v < 0) {
+          append(superscript ? "⁻" : "-");
+          v = -v;
+        }
+        std::intmax_t div = 1;
+        while (v / div >= 10) div *= 10;
+        for (; div > 0; div /= 10) append((superscript ? superscript_digits : digits)[(v / div) % 10]);
+      }
+
+      [[nodiscard]] constexpr std::string_view view() const { return std::string_view(data, size); }
+    };
+
+    inline constexpr std::size_t max_unit_text_size = 96;
+
+    // symbols of the coherent units of base dimensions indexed with dim_id
+    inline constexpr std::string_view base_unit_symbols[] = {"m", "kg", "s", "A", "K", "mol", "cd"};
+
+    struct prefix {
+      std::intmax_t num;
+      std::intmax_t den;
+      std::string_view symbol;
+    };
+
+    inline constexpr prefix si_prefixes[] = {
+        {1, std::atto::den, "a"}, {1, std::femto::den, "f"}, {1, std::pico::den, "p"}, {1, std::nano::den, "n"},
+        {1, std::micro::den, "µ"}, {1, std::milli::den, "m"}, {1, std::centi::den, "c"}, {1, std::deci::den, "d"},
+        {std::deca::num, 1, "da"}, {std::hecto::num, 1, "h"}, {std::kilo::num, 1, "k"}, {std::mega::num, 1, "M"},
+        {std::giga::num, 1, "G"}, {std::tera::num, 1, "T"}, {std::peta::num, 1, "P"}, {std::exa::num, 1, "E"}};
+
+    template<typename Buffer>
+    constexpr void append_base_unit(Buffer& b, std::size_t dim_id, int exp)
+    {
+      b.append(base_unit_symbols[dim_id]);
+      if (exp != 1) b.append(exp, true);
+    }
+
+    template<Exponent... Es>
+    constexpr void append_dimension(symbol_buffer<max_unit_text_size>& b, dimension<Es...>)
+    {
+      constexpr std::size_t num_count = ((Es::value > 0 ? 1 : 0) + ... + 0);
+      constexpr std::size_t den_count = sizeof...(Es) - num_count;
+
+      // exponents are sorted so the positive ones come first
+      bool first = true;
+      auto append_num = [&](std::size_t id, int exp) {
+        if (exp < 0) return;
+        if (!first) b.append("⋅");
+        append_base_unit(b, id, exp);
+        first = false;
+      };
+      (append_num(Es::dimension::value, Es::value), ...);
+
+      if constexpr (den_count > 0) {
+        if constexpr (num_count == 0) b.append("1");
+        b.append(den_count > 1 ? "/(" : "/");
+        first = true;
+        auto append_den = [&](std::size_t id, int exp) {
+          if (exp > 0) return;
+          if (!first) b.append("⋅");
+          append_base_unit(b, id, -exp);
+          first = false;
+        };
+        (append_den(Es::dimension::value, Es::value), ...);
+        if constexpr (den_count > 1) b.append(")");
+      }
+    }
+
+    template<Dimension D>
+    struct single_base_dimension : std::false_type {
+      static constexpr std::size_t id = 0;
+    };
+
+    template<typename BaseDim>
+    struct single_base_dimension<dimension<exp<BaseDim, 1>>> : std::true_type {
+      static constexpr std::size_t id = BaseDim::value;
+    };
+
+    // Symbol of a unit without a name: an SI prefix of a base unit (i.e. "mg") or the ratio
+    // in brackets followed by the coherent unit of the dimension (i.e. "[1/60] m/s").
+    template<Unit U>
+    constexpr symbol_buffer<max_unit_text_size> make_unit_text()
+    {
+      symbol_buffer<max_unit_text_size> b;
+      using dim = typename U::dimension::base_type;
+      using base = single_base_dimension<dim>;
+      // prefixes of mass apply to gram
+      constexpr bool is_mass = base::value && base::id == base_dim_mass::value;
+      using r = conditional<is_mass, ratio_multiply<typename U::ratio, ratio<1000>>, typename U::ratio>;
+
+      if constexpr (base::value) {
+        for (const auto& p : si_prefixes) {
+          if (p.num == r::num && p.den == r::den) {
+            b.append(p.symbol);
+            b.append(is_mass ? "g" : base_unit_symbols[base::id]);
+            return b;
+          }
+        }
+      }
+      if constexpr (is_mass && r::num == 1 && r::den == 1) {
+        b.append("g");
+        return b;
+      }
+
+      using ur = typename U::ratio;
+      if constexpr (ur::num != 1 || ur::den != 1) {
+        b.append("[");
+        b.append(ur::num);
+        if constexpr (ur::den != 1) {
+          b.append("/");
+          b.append(ur::den);
+        }
+        b.append("] ");
+      }
+      append_dimension(b, dim());
+      return b;
+    }
+
+    template<Unit U>
+    inline constexpr symbol_buffer<max_unit_text_size> unit_text_storage = make_unit_text<U>();
+
+    // longest text of a rep produced by std::to_chars (shortest round-trip representation)
+    inline constexpr std::size_t max_rep_chars = 64;
+
+  }  // namespace detail
+
+  // unit_text
+  //
+  // Symbol of any unit: unit_symbol of the named units or the one composed from the dimension
+  // and the ratio of the unit for the other ones (i.e. "K/m" for a temperature gradient).
+
+  template<Unit U>
+  inline constexpr std::string_view unit_text =
+      unit_symbol<U>.empty() ? detail::unit_text_storage<U>.view() : unit_symbol<U>;
+
+  // to_chars
+  //
+  // Writes the value and the unit symbol of a quantity (i.e. "12.5 km/h") to [first, last).
+  // Does not allocate or throw. On failure returns std::errc::value_too_large and ptr == last.
+
+  template<Dimension D, Unit U, Scalar Rep>
+  std::to_chars_result to_chars(char* first, char* last, const quantity<D, U, Rep>& q) noexcept
+  {
+    constexpr std::string_view symbol = unit_text<U>;
+    auto [ptr, ec] = detail::number_to_chars(first, last, q.count());
+    if (ec != std::errc()) return {last, ec};
+    if (static_cast<std::size_t>(last - ptr) < symbol.size() + 1) return {last, std::errc::value_too_large};
+    *ptr++ = ' ';
+    return {std::copy(symbol.begin(), symbol.end(), ptr), std::errc()};
+  }
+
+  // format_to
+  //
+  // Writes the text of a quantity to the output iterator with no dynamic allocations.
+
+  template<typename OutputIt, Dimension D, Unit U, Scalar Rep>
+  OutputIt format_to(OutputIt out, const quantity<D, U, Rep>& q)
+  {
+    char buffer[detail::max_rep_chars + 1 + unit_text<U>.size()];
+    auto [ptr, ec] = to_chars(std::begin(buffer), std::end(buffer), q);
+    Expects(ec == std::errc());
+    return std::copy(std::begin(buffer), ptr, out);
+  }
+
+  template<typename Traits, Dimension D, Unit U, Scalar Rep>
+  std::basic_ostream<char, Traits>& operator<<(std::basic_ostream<char, Traits>& os, const quantity<D, U, Rep>& q)
+  {
+    char buffer[detail::max_rep_chars + 1 + unit_text<U>.size()];
+    auto [ptr, ec] = to_chars(std::begin(buffer), std::end(buffer), q);
+    Expects(ec == std::errc());
+    return os << std::basic_string_view<char, Traits>(buffer, static_cast<std::size_t>(ptr - buffer));
+  }
+
+}  // namespace units
+
+#ifdef __cpp_lib_format
+
+// std::format support
+//
+// The format specification applies to the value (i.e. "{:.2f}") and is followed by the unit symbol.
+
+template<typename D, typename U, typename Rep>
+struct std::formatter<units::quantity<D, U, Rep>, char> : std::formatter<Rep, char> {
+  template<typename FormatContext>
+  auto format(const units::quantity<D, U, Rep>& q, FormatContext& ctx) const
+  {
+    auto out = std::formatter<Rep, char>::format(q.count(), ctx);
+    *out++ = ' ';
+    return std::copy(units::unit_text<U>.begin(), units::unit_text<U>.end(), out);
+  }
+};
+
+#endif  // __cpp_lib_format
@@ -38,21 +38,33 @@ namespace units {
 
   struct hertz : derived_unit<dimension_frequency, second> {};
   template<> struct upcasting_traits<upcast_from<hertz>> : upcast_to<hertz> {};
+  template<> inline constexpr std::string_view unit_symbol<hertz> = "Hz";
+  UNITS_EXTERN_QUANTITY(hertz);
 
   struct millihertz : milli<hertz> {};
   template<> struct upcasting_traits<upcast_from<millihertz>> : upcast_to<millihertz> {};
+  template<> inline constexpr std::string_view unit_symbol<millihertz> = "mHz";
+  UNITS_EXTERN_QUANTITY(millihertz);
 
   struct kilohertz : kilo<hertz> {};
   template<> struct upcasting_traits<upcast_from<kilohertz>> : upcast_to<kilohertz> {};
+  template<> inline constexpr std::string_view unit_symbol<kilohertz> = "kHz";
+  UNITS_EXTERN_QUANTITY(kilohertz);
 
   struct megahertz : mega<hertz> {};
   template<> struct upcasting_traits<upcast_from<megahertz>> : upcast_to<megahertz> {};
+  template<> inline constexpr std::string_view unit_symbol<megahertz> = "MHz";
+  UNITS_EXTERN_QUANTITY(megahertz);
 
   struct gigahertz : giga<hertz> {};
   template<> struct upcasting_traits<upcast_from<gigahertz>> : upcast_to<gigahertz> {};
+  template<> inline constexpr std::string_view unit_symbol<gigahertz> = "GHz";
+  UNITS_EXTERN_QUANTITY(gigahertz);
 
   struct terahertz : tera<hertz> {};
   template<> struct upcasting_traits<upcast_from<terahertz>> : upcast_to<terahertz> {};
+  template<> inline constexpr std::string_view unit_symbol<terahertz> = "THz";
+  UNITS_EXTERN_QUANTITY(terahertz);
 
   inline namespace literals {
 
@@ -0,0 +1,208 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/time.h>
+#include <units/bits/concurrency.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace units {
+
+  namespace detail {
+
+    // log_linear_buckets
+    //
+    // HdrHistogram-like bucketing. Values smaller than 2^SubBucketBits get their own buckets. Larger
+    // values are grouped by their highest set bit and every group is split into 2^(SubBucketBits - 1)
+    // linear sub-buckets which bounds the relative error of a bucket to 2^(1 - SubBucketBits).
+
+    template<unsigned SubBucketBits>
+    struct log_linear_buckets {
+      static_assert(SubBucketBits >= 2 && SubBucketBits < 32);
+
+      static constexpr std::uint64_t sub_bucket_count = std::uint64_t(1) << SubBucketBits;
+      static constexpr std::uint64_t half_sub_bucket_count = sub_bucket_count / 2;
+      static constexpr std::size_t count = (64 - SubBucketBits + 2) * half_sub_bucket_count;
+
+      [[nodiscard]] static constexpr std::size_t index(std::uint64_t value) noexcept
+      {
+        if (value < sub_bucket_count) return value;
+        const unsigned shift = 64 - __builtin_clzll(value) - SubBucketBits;
+        return shift * half_sub_bucket_count + (value >> shift);
+      }
+
+      [[nodiscard]] static constexpr std::uint64_t lowest_value(std::size_t index) noexcept
+      {
+        if (index < sub_bucket_count) return index;
+        const unsigned shift = index / half_sub_bucket_count - 1;
+        return (index - shift * half_sub_bucket_count) << shift;
+      }
+
+      [[nodiscard]] static constexpr std::uint64_t highest_value(std::size_t index) noexcept
+      {
+        if (index < sub_bucket_count) return index;
+        const unsigned shift = index / half_sub_bucket_count - 1;
+        return ((index - shift * half_sub_bucket_count + 1) << shift) - 1;
+      }
+    };
+
+  }  // namespace detail
+
+  // histogram_snapshot
+  //
+  // Plain (not thread-safe) log-linear histogram of time quantities. Returned by
+  // latency_histogram::snapshot() and mergeable with other snapshots of the same type.
+
+  template<Time T, unsigned SubBucketBits = 7>
+      requires std::Integral<typename T::rep>
+  class histogram_snapshot {
+  public:
+    using buckets = detail::log_linear_buckets<SubBucketBits>;
+
+  private:
+    std::vector<std::uint64_t> counts_ = std::vector<std::uint64_t>(buckets::count);
+    std::uint64_t total_ = 0;
+
+    template<Time T2, unsigned S>
+        requires std::Integral<typename T2::rep>
+    friend class latency_histogram;
+
+  public:
+    template<Time T2>
+    void record(const T2& sample, std::uint64_t count = 1)
+    {
+      const auto value = quantity_cast<T>(sample).count();
+      counts_[buckets::index(value > 0 ? static_cast<std::uint64_t>(value) : 0)] += count;
+      total_ += count;
+    }
+
+    histogram_snapshot& operator+=(const histogram_snapshot& other)
+    {
+      std::transform(counts_.begin(), counts_.end(), other.counts_.begin(), counts_.begin(), std::plus<>());
+      total_ += other.total_;
+      return *this;
+    }
+
+    [[nodiscard]] std::uint64_t total_count() const noexcept { return total_; }
+
+    [[nodiscard]] std::uint64_t count_at(std::size_t bucket) const { return counts_[bucket]; }
+
+    // Returns the highest value equivalent (within the histogram precision) to the given percentile.
+    [[nodiscard]] T value_at_percentile(double percentile) const
+    {
+      if (total_ == 0) return T::zero();
+      const double p = std::clamp(percentile, 0.0, 100.0);
+      const auto target = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(p / 100.0 * total_ + 0.5));
+      std::uint64_t sum = 0;
+      std::size_t i = 0;
+      for (; i < counts_.size(); ++i) {
+        sum += counts_[i];
+        if (sum >= target) break;
+      }
+      using rep = T::rep;
+      constexpr auto max_value = static_cast<std::uint64_t>(std::numeric_limits<rep>::max());
+      return T(static_cast<rep>(std::min(buckets::highest_value(i), max_value)));
+    }
+
+    [[nodiscard]] T min() const { return value_at_percentile(0.0); }
+    [[nodiscard]] T max() const { return value_at_percentile(100.0); }
+  };
+
+  // latency_histogram
+  //
+  // Concurrent recorder of time samples. Every thread records into its own shard with a single
+  // relaxed fetch_add so recording is O(1), wait-free and does not allocate. snapshot() merges all
+  // the shards into a histogram_snapshot that answers percentile queries.
+
+  template<Time T, unsigned SubBucketBits = 7>
+      requires std::Integral<typename T::rep>
+  class latency_histogram {
+  public:
+    using snapshot_type = histogram_snapshot<T, SubBucketBits>;
+    using buckets = snapshot_type::buckets;
+
+  private:
+    // round up the shard size to whole cache lines so that shards do not share them
+    static constexpr std::size_t counters_per_line = detail::cache_line_size / sizeof(std::atomic<std::uint64_t>);
+    static constexpr std::size_t shard_stride =
+        (buckets::count + counters_per_line - 1) / counters_per_line * counters_per_line;
+
+    struct alignas(detail::cache_line_size) counter_line {
+      std::atomic<std::uint64_t> counters[counters_per_line];
+    };
+
+    std::size_t mask_;
+    std::unique_ptr<counter_line[]> lines_;
+
+    [[nodiscard]] std::atomic<std::uint64_t>& counter(std::size_t shard, std::size_t bucket) const noexcept
+    {
+      const std::size_t i = shard * shard_stride + bucket;
+      return lines_[i / counters_per_line].counters[i % counters_per_line];
+    }
+
+  public:
+    explicit latency_histogram(std::size_t shards = std::thread::hardware_concurrency())
+        : mask_(detail::shard_count(shards) - 1),
+          lines_(new counter_line[(mask_ + 1) * shard_stride / counters_per_line]())
+    {
+    }
+
+    latency_histogram(const latency_histogram&) = delete;
+    latency_histogram& operator=(const latency_histogram&) = delete;
+
+    template<Time T2>
+    void record(const T2& sample) noexcept
+    {
+      const auto value = quantity_cast<T>(sample).count();
+      const std::size_t bucket = buckets::index(value > 0 ? static_cast<std::uint64_t>(value) : 0);
+      counter(detail::this_thread_index() & mask_, bucket).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] snapshot_type snapshot() const
+    {
+      snapshot_type result;
+      for (std::size_t shard = 0; shard <= mask_; ++shard)
+        for (std::size_t bucket = 0; bucket < buckets::count; ++bucket) {
+          const std::uint64_t c = counter(shard, bucket).load(std::memory_order_relaxed);
+          result.counts_[bucket] += c;
+          result.total_ += c;
+        }
+      return result;
+    }
+
+    void reset() noexcept
+    {
+      for (std::size_t shard = 0; shard <= mask_; ++shard)
+        for (std::size_t bucket = 0; bucket < buckets::count; ++bucket)
+          counter(shard, bucket).store(0, std::memory_order_relaxed);
+    }
+  };
+
+}  // namespace units
@@ -39,15 +39,23 @@ namespace units {
   // SI units
   struct meter : unit<dimension_length> {};
   template<> struct upcasting_traits<upcast_from<meter>> : upcast_to<meter> {};
+  template<> inline constexpr std::string_view unit_symbol<meter> = "m";
+  UNITS_EXTERN_QUANTITY(meter);
 
   struct millimeter : milli<meter> {};
   template<> struct upcasting_traits<upcast_from<millimeter>> : upcast_to<millimeter> {};
+  template<> inline constexpr std::string_view unit_symbol<millimeter> = "mm";
+  UNITS_EXTERN_QUANTITY(millimeter);
 
   struct centimeter : centi<meter> {};
   template<> struct upcasting_traits<upcast_from<centimeter>> : upcast_to<centimeter> {};
+  template<> inline constexpr std::string_view unit_symbol<centimeter> = "cm";
+  UNITS_EXTERN_QUANTITY(centimeter);
 
   struct kilometer : kilo<meter> {};
   template<> struct upcasting_traits<upcast_from<kilometer>> : upcast_to<kilometer> {};
+  template<> inline constexpr std::string_view unit_symbol<kilometer> = "km";
+  UNITS_EXTERN_QUANTITY(kilometer);
 
   inline namespace literals {
 
@@ -72,15 +80,23 @@ namespace units {
   // US customary units
   struct yard : unit<dimension_length, ratio<9'144, 10'000>> {};
   template<> struct upcasting_traits<upcast_from<yard>> : upcast_to<yard> {};
+  template<> inline constexpr std::string_view unit_symbol<yard> = "yd";
+  UNITS_EXTERN_QUANTITY(yard);
 
   struct foot : unit<dimension_length, ratio_multiply<ratio<1, 3>, yard::ratio>> {};
   template<> struct upcasting_traits<upcast_from<foot>> : upcast_to<foot> {};
+  template<> inline constexpr std::string_view unit_symbol<foot> = "ft";
+  UNITS_EXTERN_QUANTITY(foot);
 
   struct inch : unit<dimension_length, ratio_multiply<ratio<1, 12>, foot::ratio>> {};
   template<> struct upcasting_traits<upcast_from<inch>> : upcast_to<inch> {};
+  template<> inline constexpr std::string_view unit_symbol<inch> = "in";
+  UNITS_EXTERN_QUANTITY(inch);
 
   struct mile : unit<dimension_length, ratio_multiply<ratio<1'760>, yard::ratio>> {};
   template<> struct upcasting_traits<upcast_from<mile>> : upcast_to<mile> {};
+  template<> inline constexpr std::string_view unit_symbol<mile> = "mi";
+  UNITS_EXTERN_QUANTITY(mile);
 
   inline namespace literals {
 
@@ -38,6 +38,8 @@ namespace units {
 
   struct candela : unit<dimension_luminous_intensity> {};
   template<> struct upcasting_traits<upcast_from<candela>> : upcast_to<candela> {};
+  template<> inline constexpr std::string_view unit_symbol<candela> = "cd";
+  UNITS_EXTERN_QUANTITY(candela);
 
   inline namespace literals {
 
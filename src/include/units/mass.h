@@ -38,9 +38,13 @@ namespace units {
 
   struct gram : unit<dimension_mass, ratio<1, 1000>> {};
   template<> struct upcasting_traits<upcast_from<gram>> : upcast_to<gram> {};
+  template<> inline constexpr std::string_view unit_symbol<gram> = "g";
+  UNITS_EXTERN_QUANTITY(gram);
 
   struct kilogram : kilo<gram> {};
   template<> struct upcasting_traits<upcast_from<kilogram>> : upcast_to<kilogram> {};
+  template<> inline constexpr std::string_view unit_symbol<kilogram> = "kg";
+  UNITS_EXTERN_QUANTITY(kilogram);
 
   inline namespace literals {
 
@@ -0,0 +1,164 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/charconv.h>
+#include <units/unit_registry.h>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace units {
+
+  // unit_conversion
+  //
+  // Symbol of a unit together with the ratio converting its values to the target unit.
+
+  struct unit_conversion {
+    std::string_view symbol;
+    std::intmax_t num;
+    std::intmax_t den;
+  };
+
+  // unit_symbol_table
+  //
+  // Compile-time perfect hash table of the symbols of all the parsable units with the dimension
+  // of the target unit U. A lookup costs one hash of the symbol and one string comparison.
+
+  template<Unit U, typename Units = registered_units>
+  class unit_symbol_table;
+
+  template<Unit U, Unit... Us>
+  class unit_symbol_table<U, unit_list<Us...>> {
+    template<Unit From>
+    static constexpr bool has_dimension = std::is_same_v<typename From::dimension, typename U::dimension>;
+
+    static constexpr std::size_t count =
+        ((has_dimension<Us> ? std::size_t(!unit_symbol<Us>.empty()) + std::size_t(!unit_symbol_alias<Us>.empty())
+                            : 0) + ... + 0);
+
+    static constexpr std::array<unit_conversion, count> entries = [] {
+      std::array<unit_conversion, count> result{};
+      std::size_t i = 0;
+      auto add = [&](std::string_view symbol, std::intmax_t num, std::intmax_t den) {
+        if (!symbol.empty()) result[i++] = {symbol, num, den};
+      };
+      (
+          [&] {
+            if constexpr (has_dimension<Us>) {
+              using r = ratio_divide<typename Us::ratio, typename U::ratio>;
+              add(unit_symbol<Us>, r::num, r::den);
+              add(unit_symbol_alias<Us>, r::num, r::den);
+            }
+          }(),
+          ...);
+      return result;
+    }();
+
+    static constexpr std::array<std::string_view, count> symbols = [] {
+      std::array<std::string_view, count> result{};
+      for (std::size_t i = 0; i < count; ++i) result[i] = entries[i].symbol;
+      return result;
+    }();
+
+    static constexpr detail::perfect_hash<count> hash = detail::make_perfect_hash(symbols);
+
+  public:
+    [[nodiscard]] static constexpr std::size_t size() noexcept { return count; }
+
+    [[nodiscard]] static constexpr const unit_conversion* find(std::string_view symbol) noexcept
+    {
+      const std::size_t i = hash.find(symbol, symbols);
+      return i < count ? &entries[i] : nullptr;
+    }
+  };
+
+  namespace detail {
+
+    [[nodiscard]] constexpr bool is_symbol_terminator(char c) noexcept
+    {
+      return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ',' || c == ';';
+    }
+
+    template<Quantity Q, typename Number>
+    [[nodiscard]] std::errc convert_parsed(Number n, const unit_conversion& c, Q& value) noexcept
+    {
+      using rep = Q::rep;
+      if constexpr (treat_as_floating_point<rep>) {
+        if (c.num != 1) n *= static_cast<Number>(c.num);
+        if (c.den != 1) n /= static_cast<Number>(c.den);
+        value = Q(static_cast<rep>(n));
+      }
+      else {
+        // values not representable exactly in the target unit (i.e. "1999 ms" as seconds) are rejected
+        if (__builtin_mul_overflow(n, c.num, &n) || n % c.den != 0) return std::errc::result_out_of_range;
+        n /= c.den;
+        if constexpr (std::is_signed_v<rep>) {
+          if (n < std::numeric_limits<rep>::lowest() || n > std::numeric_limits<rep>::max())
+            return std::errc::result_out_of_range;
+        }
+        else if (n < 0 || static_cast<std::make_unsigned_t<Number>>(n) > std::numeric_limits<rep>::max())
+          return std::errc::result_out_of_range;
+        value = Q(static_cast<rep>(n));
+      }
+      return std::errc();
+    }
+
+  }  // namespace detail
+
+  // from_chars
+  //
+  // Parses a number followed by an optional space and a unit symbol (i.e. "12.5 km/h" or "300ms")
+  // into the quantity Q. The unit has to have the dimension of Q and its value is converted to the
+  // unit of Q. The symbol ends at a whitespace, ',', ';' or at `last`. Does not allocate or throw;
+  // on failure returns std::errc::invalid_argument or std::errc::result_out_of_range (also for a value
+  // that an integral Q cannot represent exactly) with ptr == first and leaves value unchanged.
+
+  template<Quantity Q>
+  std::from_chars_result from_chars(const char* first, const char* last, Q& value) noexcept
+  {
+    using number = conditional<treat_as_floating_point<typename Q::rep>, std::common_type_t<typename Q::rep, double>,
+                               std::intmax_t>;
+    number n{};
+    auto [ptr, ec] = detail::number_from_chars(first, last, n);
+    if (ec != std::errc()) return {first, ec};
+
+    while (ptr != last && *ptr == ' ') ++ptr;
+    const char* symbol_first = ptr;
+    while (ptr != last && !detail::is_symbol_terminator(*ptr)) ++ptr;
+
+    const std::string_view symbol(symbol_first, static_cast<std::size_t>(ptr - symbol_first));
+    const unit_conversion* c = unit_symbol_table<typename Q::unit>::find(symbol);
+    if (c == nullptr) return {first, std::errc::invalid_argument};
+
+    if (auto err = detail::convert_parsed(n, *c, value); err != std::errc()) return {first, err};
+    return {ptr, std::errc()};
+  }
+
+}  // namespace units
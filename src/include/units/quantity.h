@@ -24,6 +24,8 @@
 
 #include <units/unit.h>
 #include <units/bits/concepts.h>
+#include <units/bits/extern_templates.h>
+#include <units/bits/inline.h>
 #include <limits>
 #include <gsl/gsl-lite.hpp>
 
@@ -85,7 +87,7 @@ namespace units {
     template<Quantity To, Ratio CR, Scalar CRep, bool NumIsOne = false, bool DenIsOne = false>
     struct quantity_cast_impl {
       template<Quantity Q>
-      static constexpr To cast(const Q& q)
+      UNITS_ALWAYS_INLINE static constexpr To cast(const Q& q)
       {
         return To(static_cast<To::rep>(static_cast<CRep>(q.count()) * static_cast<CRep>(CR::num) /
                                        static_cast<CRep>(CR::den)));
@@ -95,7 +97,7 @@ namespace units {
     template<Quantity To, Ratio CR, Scalar CRep>
     struct quantity_cast_impl<To, CR, CRep, true, true> {
       template<Quantity Q>
-      static constexpr To cast(const Q& q)
+      UNITS_ALWAYS_INLINE static constexpr To cast(const Q& q)
       {
         return To(static_cast<To::rep>(q.count()));
       }
@@ -104,7 +106,7 @@ namespace units {
     template<Quantity To, Ratio CR, Scalar CRep>
     struct quantity_cast_impl<To, CR, CRep, true, false> {
       template<Quantity Q>
-      static constexpr To cast(const Q& q)
+      UNITS_ALWAYS_INLINE static constexpr To cast(const Q& q)
       {
         return To(static_cast<To::rep>(static_cast<CRep>(q.count()) / static_cast<CRep>(CR::den)));
       }
@@ -113,7 +115,7 @@ namespace units {
     template<Quantity To, Ratio CR, Scalar CRep>
     struct quantity_cast_impl<To, CR, CRep, false, true> {
       template<Quantity Q>
-      static constexpr To cast(const Q& q)
+      UNITS_ALWAYS_INLINE static constexpr To cast(const Q& q)
       {
         return To(static_cast<To::rep>(static_cast<CRep>(q.count()) * static_cast<CRep>(CR::num)));
       }
@@ -123,7 +125,7 @@ namespace units {
 
   template<Quantity To, Dimension D, Unit U, Scalar Rep>
       requires std::Same<typename To::dimension, D>
-  constexpr To quantity_cast(const quantity<D, U, Rep>& q)
+  UNITS_ALWAYS_INLINE constexpr To quantity_cast(const quantity<D, U, Rep>& q)
   {
     using c_ratio = ratio_divide<typename U::ratio, typename To::unit::ratio>;
     using c_rep = std::common_type_t<typename To::rep, Rep, intmax_t>;
@@ -131,14 +133,38 @@ namespace units {
     return cast::cast(q);
   }
 
+  namespace detail {
+
+    // Converts many values of the same quantity type. For floating-point reps the ratio is folded into
+    // a single constant factor so each element costs one multiplication instead of a multiplication
+    // and a division (the result may differ from quantity_cast in the last bit).
+    template<Quantity To, Quantity From>
+        requires std::Same<typename To::dimension, typename From::dimension>
+    struct quantity_converter {
+      using c_ratio = ratio_divide<typename From::unit::ratio, typename To::unit::ratio>;
+      using c_rep = std::common_type_t<typename To::rep, typename From::rep, intmax_t>;
+      static constexpr bool folded = treat_as_floating_point<c_rep> && c_ratio::den != 1;
+      static constexpr c_rep factor = static_cast<c_rep>(c_ratio::num) / static_cast<c_rep>(c_ratio::den);
+
+      UNITS_ALWAYS_INLINE constexpr To operator()(const From& q) const
+      {
+        if constexpr (folded)
+          return To(static_cast<To::rep>(static_cast<c_rep>(q.count()) * factor));
+        else
+          return quantity_cast<To>(q);
+      }
+    };
+
+  }  // namespace detail
+
   // quantity_values
 
   template<Scalar Rep>
   struct quantity_values {
-    static constexpr Rep zero() noexcept { return Rep(0); }
-    static constexpr Rep one() noexcept { return Rep(1); }
-    static constexpr Rep max() noexcept { return std::numeric_limits<Rep>::max(); }
-    static constexpr Rep min() noexcept { return std::numeric_limits<Rep>::lowest(); }
+    UNITS_ALWAYS_INLINE static constexpr Rep zero() noexcept { return Rep(0); }
+    UNITS_ALWAYS_INLINE static constexpr Rep one() noexcept { return Rep(1); }
+    UNITS_ALWAYS_INLINE static constexpr Rep max() noexcept { return std::numeric_limits<Rep>::max(); }
+    UNITS_ALWAYS_INLINE static constexpr Rep min() noexcept { return std::numeric_limits<Rep>::lowest(); }
   };
 
   // quantity
@@ -160,7 +186,7 @@ namespace units {
 
     template<std::ConvertibleTo<rep> Rep2>
         requires treat_as_floating_point<rep> || (!treat_as_floating_point<Rep2>)
-    constexpr explicit quantity(const Rep2& r) : value_{static_cast<rep>(r)}
+    UNITS_ALWAYS_INLINE constexpr explicit quantity(const Rep2& r) : value_{static_cast<rep>(r)}
     {
     }
 
@@ -170,67 +196,67 @@ namespace units {
                  (treat_as_floating_point<rep> ||
                    (std::ratio_divide<typename Q2::unit::ratio, typename unit::ratio>::den == 1 &&
                    !treat_as_floating_point<typename Q2::rep>))
-    constexpr quantity(const Q2& q) : value_{quantity_cast<quantity>(q).count()}
+    UNITS_ALWAYS_INLINE constexpr quantity(const Q2& q) : value_{quantity_cast<quantity>(q).count()}
     {
     }
 
     quantity& operator=(const quantity& other) = default;
 
-    [[nodiscard]] constexpr rep count() const noexcept { return value_; }
+    [[nodiscard]] UNITS_ALWAYS_INLINE constexpr rep count() const noexcept { return value_; }
 
     [[nodiscard]] static constexpr quantity zero() noexcept { return quantity(quantity_values<Rep>::zero()); }
     [[nodiscard]] static constexpr quantity one() noexcept { return quantity(quantity_values<Rep>::one()); }
     [[nodiscard]] static constexpr quantity min() noexcept { return quantity(quantity_values<Rep>::min()); }
     [[nodiscard]] static constexpr quantity max() noexcept { return quantity(quantity_values<Rep>::max()); }
 
-    [[nodiscard]] constexpr quantity operator+() const { return quantity(*this); }
-    [[nodiscard]] constexpr quantity operator-() const { return quantity(-count()); }
+    [[nodiscard]] UNITS_ALWAYS_INLINE constexpr quantity operator+() const { return quantity(*this); }
+    [[nodiscard]] UNITS_ALWAYS_INLINE constexpr quantity operator-() const { return quantity(-count()); }
 
-    constexpr quantity& operator++()
+    UNITS_ALWAYS_INLINE constexpr quantity& operator++()
     {
       ++value_;
       return *this;
     }
-    constexpr quantity operator++(int) { return quantity(value_++); }
+    UNITS_ALWAYS_INLINE constexpr quantity operator++(int) { return quantity(value_++); }
 
-    constexpr quantity& operator--()
+    UNITS_ALWAYS_INLINE constexpr quantity& operator--()
     {
       --value_;
       return *this;
     }
-    constexpr quantity operator--(int) { return quantity(value_--); }
+    UNITS_ALWAYS_INLINE constexpr quantity operator--(int) { return quantity(value_--); }
 
-    constexpr quantity& operator+=(const quantity& q)
+    UNITS_ALWAYS_INLINE constexpr quantity& operator+=(const quantity& q)
     {
       value_ += q.count();
       return *this;
     }
 
-    constexpr quantity& operator-=(const quantity& q)
+    UNITS_ALWAYS_INLINE constexpr quantity& operator-=(const quantity& q)
     {
       value_ -= q.count();
       return *this;
     }
 
-    constexpr quantity& operator*=(const rep& rhs)
+    UNITS_ALWAYS_INLINE constexpr quantity& operator*=(const rep& rhs)
     {
       value_ *= rhs;
       return *this;
     }
 
-    constexpr quantity& operator/=(const rep& rhs)
+    UNITS_ALWAYS_INLINE constexpr quantity& operator/=(const rep& rhs)
     {
       value_ /= rhs;
       return *this;
     }
 
-    constexpr quantity& operator%=(const rep& rhs)
+    UNITS_ALWAYS_INLINE constexpr quantity& operator%=(const rep& rhs) requires(!treat_as_floating_point<rep>)
     {
       value_ %= rhs;
       return *this;
     }
 
-    constexpr quantity& operator%=(const quantity& q)
+    UNITS_ALWAYS_INLINE constexpr quantity& operator%=(const quantity& q) requires(!treat_as_floating_point<rep>)
     {
       value_ %= q.count();
       return *this;
@@ -239,8 +265,8 @@ namespace units {
 
   // clang-format off
   template<Dimension D, Unit U1, Scalar Rep1, Unit U2, Scalar Rep2>
-  [[nodiscard]] constexpr Quantity operator+(const quantity<D, U1, Rep1>& lhs,
-                                             const quantity<D, U2, Rep2>& rhs)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr Quantity operator+(const quantity<D, U1, Rep1>& lhs,
+                                                                 const quantity<D, U2, Rep2>& rhs)
   {
     using common_rep = decltype(lhs.count() + rhs.count());
     using ret = common_quantity_t<quantity<D, U1, Rep1>, quantity<D, U2, Rep2>, common_rep>;
@@ -248,8 +274,8 @@ namespace units {
   }
 
   template<Dimension D, Unit U1, Scalar Rep1, Unit U2, Scalar Rep2>
-  [[nodiscard]] constexpr Quantity operator-(const quantity<D, U1, Rep1>& lhs,
-                                             const quantity<D, U2, Rep2>& rhs)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr Quantity operator-(const quantity<D, U1, Rep1>& lhs,
+                                                                 const quantity<D, U2, Rep2>& rhs)
   {
     using common_rep = decltype(lhs.count() - rhs.count());
     using ret = common_quantity_t<quantity<D, U1, Rep1>, quantity<D, U2, Rep2>, common_rep>;
@@ -258,8 +284,8 @@ namespace units {
 
 //  template<Dimension D, Unit U, Scalar Rep1, Scalar Rep2>
   template<typename D, typename U, typename Rep1, typename Rep2>
-  [[nodiscard]] constexpr Quantity operator*(const quantity<D, U, Rep1>& q,
-                                             const Rep2& v)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr Quantity operator*(const quantity<D, U, Rep1>& q,
+                                                                 const Rep2& v)
     requires (!Quantity<Rep2>)
   {
     using common_rep = decltype(q.count()* v);
@@ -269,16 +295,16 @@ namespace units {
 
   //template<Scalar Rep1, Dimension D, Unit U, Scalar Rep2>
   template<typename Rep1, typename D, typename U, typename Rep2>
-  [[nodiscard]] constexpr Quantity operator*(const Rep1& v,
-                                             const quantity<D, U, Rep2>& q)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr Quantity operator*(const Rep1& v,
+                                                                 const quantity<D, U, Rep2>& q)
     requires (!Quantity<Rep1>)
   {
     return q * v;
   }
 
   template<Dimension D1, Unit U1, Scalar Rep1, Dimension D2, Unit U2, Scalar Rep2>
-  [[nodiscard]] constexpr Quantity operator*(const quantity<D1, U1, Rep1>& lhs,
-                                             const quantity<D2, U2, Rep2>& rhs)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr Quantity operator*(const quantity<D1, U1, Rep1>& lhs,
+                                                                 const quantity<D2, U2, Rep2>& rhs)
       requires treat_as_floating_point<decltype(lhs.count() * rhs.count())> ||
                (std::ratio_multiply<typename U1::ratio, typename U2::ratio>::den == 1)
   {
@@ -290,8 +316,8 @@ namespace units {
 
 //  template<Scalar Rep1, Dimension D, Unit U, Scalar Rep2>
   template<typename Rep1, typename D, typename U, typename Rep2>
-  [[nodiscard]] constexpr Quantity operator/(const Rep1& v,
-                                             const quantity<D, U, Rep2>& q)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr Quantity operator/(const Rep1& v,
+                                                                 const quantity<D, U, Rep2>& q)
     requires (!Quantity<Rep1>)
   {
     Expects(q != std::remove_cvref_t<decltype(q)>(0));
@@ -305,8 +331,8 @@ namespace units {
 
 //  template<Dimension D, Unit U, Scalar Rep1, Scalar Rep2>
   template<typename D, typename U, typename Rep1, typename Rep2>
-  [[nodiscard]] constexpr Quantity operator/(const quantity<D, U, Rep1>& q,
-                                             const Rep2& v)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr Quantity operator/(const quantity<D, U, Rep1>& q,
+                                                                 const Rep2& v)
     requires (!Quantity<Rep2>)
   {
     Expects(v != Rep2{0});
@@ -317,8 +343,8 @@ namespace units {
   }
 
   template<Dimension D, Unit U1, Scalar Rep1, Unit U2, Scalar Rep2>
-  [[nodiscard]] constexpr Scalar operator/(const quantity<D, U1, Rep1>& lhs,
-                                           const quantity<D, U2, Rep2>& rhs)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr Scalar operator/(const quantity<D, U1, Rep1>& lhs,
+                                                               const quantity<D, U2, Rep2>& rhs)
   {
     Expects(rhs != std::remove_cvref_t<decltype(rhs)>(0));
 
@@ -328,8 +354,8 @@ namespace units {
   }
 
   template<Dimension D1, Unit U1, Scalar Rep1, Dimension D2, Unit U2, Scalar Rep2>
-  [[nodiscard]] constexpr Quantity operator/(const quantity<D1, U1, Rep1>& lhs,
-                                             const quantity<D2, U2, Rep2>& rhs)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr Quantity operator/(const quantity<D1, U1, Rep1>& lhs,
+                                                                 const quantity<D2, U2, Rep2>& rhs)
     requires treat_as_floating_point<decltype(lhs.count() / rhs.count())> ||
              (ratio_divide<typename U1::ratio, typename U2::ratio>::den == 1)
   {
@@ -342,8 +368,8 @@ namespace units {
   }
 
   template<Dimension D, Unit U, Scalar Rep1, Scalar Rep2>
-  [[nodiscard]] constexpr Quantity operator%(const quantity<D, U, Rep1>& q,
-                                             const Rep2& v)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr Quantity operator%(const quantity<D, U, Rep1>& q,
+                                                                 const Rep2& v)
   {
     using common_rep = decltype(q.count() % v);
     using ret = quantity<D, U, common_rep>;
@@ -351,8 +377,8 @@ namespace units {
   }
 
   template<Dimension D, Unit U1, Scalar Rep1, Unit U2, Scalar Rep2>
-  [[nodiscard]] constexpr Quantity operator%(const quantity<D, U1, Rep1>& lhs,
-                                             const quantity<D, U2, Rep2>& rhs)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr Quantity operator%(const quantity<D, U1, Rep1>& lhs,
+                                                                 const quantity<D, U2, Rep2>& rhs)
   {
     using common_rep = decltype(lhs.count() % rhs.count());
     using ret = common_quantity_t<quantity<D, U1, Rep1>, quantity<D, U2, Rep2>, common_rep>;
@@ -362,39 +388,45 @@ namespace units {
   // clang-format on
 
   template<Dimension D, Unit U1, Scalar Rep1, Unit U2, Scalar Rep2>
-  [[nodiscard]] constexpr bool operator==(const quantity<D, U1, Rep1>& lhs, const quantity<D, U2, Rep2>& rhs)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr bool operator==(const quantity<D, U1, Rep1>& lhs,
+                                                              const quantity<D, U2, Rep2>& rhs)
   {
     using ct = common_quantity_t<quantity<D, U1, Rep1>, quantity<D, U2, Rep2>>;
     return ct(lhs).count() == ct(rhs).count();
   }
 
   template<Dimension D, Unit U1, Scalar Rep1, Unit U2, Scalar Rep2>
-  [[nodiscard]] constexpr bool operator!=(const quantity<D, U1, Rep1>& lhs, const quantity<D, U2, Rep2>& rhs)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr bool operator!=(const quantity<D, U1, Rep1>& lhs,
+                                                              const quantity<D, U2, Rep2>& rhs)
   {
     return !(lhs == rhs);
   }
 
   template<Dimension D, Unit U1, Scalar Rep1, Unit U2, Scalar Rep2>
-  [[nodiscard]] constexpr bool operator<(const quantity<D, U1, Rep1>& lhs, const quantity<D, U2, Rep2>& rhs)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr bool operator<(const quantity<D, U1, Rep1>& lhs,
+                                                             const quantity<D, U2, Rep2>& rhs)
   {
     using ct = common_quantity_t<quantity<D, U1, Rep1>, quantity<D, U2, Rep2>>;
     return ct(lhs).count() < ct(rhs).count();
   }
 
   template<Dimension D, Unit U1, Scalar Rep1, Unit U2, Scalar Rep2>
-  [[nodiscard]] constexpr bool operator<=(const quantity<D, U1, Rep1>& lhs, const quantity<D, U2, Rep2>& rhs)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr bool operator<=(const quantity<D, U1, Rep1>& lhs,
+                                                              const quantity<D, U2, Rep2>& rhs)
   {
     return !(rhs < lhs);
   }
 
   template<Dimension D, Unit U1, Scalar Rep1, Unit U2, Scalar Rep2>
-  [[nodiscard]] constexpr bool operator>(const quantity<D, U1, Rep1>& lhs, const quantity<D, U2, Rep2>& rhs)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr bool operator>(const quantity<D, U1, Rep1>& lhs,
+                                                             const quantity<D, U2, Rep2>& rhs)
   {
     return rhs < lhs;
   }
 
   template<Dimension D, Unit U1, Scalar Rep1, Unit U2, Scalar Rep2>
-  [[nodiscard]] constexpr bool operator>=(const quantity<D, U1, Rep1>& lhs, const quantity<D, U2, Rep2>& rhs)
+  [[nodiscard]] UNITS_ALWAYS_INLINE constexpr bool operator>=(const quantity<D, U1, Rep1>& lhs,
+                                                              const quantity<D, U2, Rep2>& rhs)
   {
     return !(lhs < rhs);
   }
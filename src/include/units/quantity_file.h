@@ -0,0 +1,377 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/base_dimensions.h>
+#include <units/quantity_span.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define UNITS_HAS_MMAP
+#endif
+
+namespace units {
+
+  // quantity_metadata
+  //
+  // Self-describing, fixed size description of the type of stored quantities: the kind and
+  // size of the rep, exponents of all the base dimensions and the ratio of the unit.
+
+  enum class rep_kind : std::uint8_t { signed_integer = 0, unsigned_integer = 1, floating_point = 2 };
+
+  struct quantity_metadata {
+    rep_kind kind;
+    std::uint8_t rep_size;
+    std::int8_t exponents[7];  // indexed with base dimension ids
+    std::uint8_t reserved[7];
+    std::int64_t ratio_num;
+    std::int64_t ratio_den;
+
+    [[nodiscard]] constexpr bool has_same_dimension(const quantity_metadata& other) const noexcept
+    {
+      for (std::size_t i = 0; i < 7; ++i)
+        if (exponents[i] != other.exponents[i]) return false;
+      return true;
+    }
+
+    // same dimension and rep; the unit may differ
+    [[nodiscard]] constexpr bool is_convertible_to(const quantity_metadata& other) const noexcept
+    {
+      return kind == other.kind && rep_size == other.rep_size && has_same_dimension(other);
+    }
+
+    [[nodiscard]] constexpr bool operator==(const quantity_metadata& other) const noexcept
+    {
+      return is_convertible_to(other) && ratio_num == other.ratio_num && ratio_den == other.ratio_den;
+    }
+  };
+
+  static_assert(sizeof(quantity_metadata) == 32);
+
+  template<Quantity Q>
+  [[nodiscard]] constexpr quantity_metadata make_quantity_metadata() noexcept
+  {
+    using rep = Q::rep;
+    using d = Q::dimension;
+    static_assert(std::is_arithmetic_v<rep>, "only arithmetic reps can be stored");
+    return quantity_metadata{
+        treat_as_floating_point<rep> ? rep_kind::floating_point
+                                     : (std::is_signed_v<rep> ? rep_kind::signed_integer : rep_kind::unsigned_integer),
+        static_cast<std::uint8_t>(sizeof(rep)),
+        {static_cast<std::int8_t>(dimension_exponent<d, base_dim_length>),
+         static_cast<std::int8_t>(dimension_exponent<d, base_dim_mass>),
+         static_cast<std::int8_t>(dimension_exponent<d, base_dim_time>),
+         static_cast<std::int8_t>(dimension_exponent<d, base_dim_current>),
+         static_cast<std::int8_t>(dimension_exponent<d, base_dim_temperature>),
+         static_cast<std::int8_t>(dimension_exponent<d, base_dim_substance>),
+         static_cast<std::int8_t>(dimension_exponent<d, base_dim_luminous_intensity>)},
+        {},
+        Q::unit::ratio::num,
+        Q::unit::ratio::den};
+  }
+
+  namespace detail {
+
+    // Ratio converting the values of the `from` unit to the `to` unit
+    [[nodiscard]] inline std::pair<std::int64_t, std::int64_t> conversion_ratio(const quantity_metadata& from,
+                                                                                const quantity_metadata& to)
+    {
+      const std::int64_t g1 = std::gcd(from.ratio_num, to.ratio_num);
+      const std::int64_t g2 = std::gcd(from.ratio_den, to.ratio_den);
+      std::int64_t num, den;
+      if (__builtin_mul_overflow(from.ratio_num / g1, to.ratio_den / g2, &num) ||
+          __builtin_mul_overflow(from.ratio_den / g2, to.ratio_num / g1, &den))
+        throw std::overflow_error("units: conversion ratio overflow");
+      return {num, den};
+    }
+
+    // Bit pattern of an arithmetic rep (sign-extended integers, IEEE 754 floating-point)
+    template<typename Rep>
+    [[nodiscard]] std::uint64_t to_bits(Rep v) noexcept
+    {
+      if constexpr (std::is_same_v<Rep, float>) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        return bits;
+      }
+      else if constexpr (std::is_same_v<Rep, double>) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        return bits;
+      }
+      else if constexpr (std::is_signed_v<Rep>) {
+        return static_cast<std::uint64_t>(static_cast<std::int64_t>(v));
+      }
+      else {
+        return static_cast<std::uint64_t>(v);
+      }
+    }
+
+  }  // namespace detail
+
+  // quantity_file_header
+  //
+  // Header of the binary file of quantities. It is followed by `count` values of the rep
+  // starting at `data_offset` (aligned to the cache line) in the native byte order.
+
+  struct quantity_file_header {
+    static constexpr char magic_value[8] = {'U', 'N', 'I', 'T', 'S', 'Q', 'T', 'Y'};
+    static constexpr std::uint32_t current_version = 1;
+    static constexpr std::uint32_t byte_order_mark = 0x01020304;
+    static constexpr std::uint64_t data_alignment = 64;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    quantity_metadata metadata;
+    std::uint64_t count;
+    std::uint64_t data_offset;
+  };
+
+  static_assert(std::is_trivially_copyable_v<quantity_file_header>);
+  static_assert(sizeof(quantity_file_header) == quantity_file_header::data_alignment);
+
+  // write_quantities
+  //
+  // Writes the quantities in the binary format. Throws std::runtime_error on failure.
+
+  template<Quantity Q>
+  void write_quantities(std::ostream& os, quantity_span<const Q> values)
+  {
+    quantity_file_header header{};
+    std::copy(std::begin(header.magic_value), std::end(header.magic_value), header.magic);
+    header.version = quantity_file_header::current_version;
+    header.byte_order = quantity_file_header::byte_order_mark;
+    header.metadata = make_quantity_metadata<Q>();
+    header.count = values.size();
+    header.data_offset = quantity_file_header::data_alignment;
+
+    char buffer[quantity_file_header::data_alignment]{};
+    std::memcpy(buffer, &header, sizeof(header));
+    os.write(buffer, sizeof(buffer));
+    os.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+    if (!os) throw std::runtime_error("units::write_quantities: write error");
+  }
+
+  template<Quantity Q>
+  void write_quantities(const std::string& path, quantity_span<const Q> values)
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) throw std::runtime_error("units::write_quantities: cannot create '" + path + "'");
+    write_quantities<Q>(file, values);
+  }
+
+  // converting_quantity_view
+  //
+  // Read-only view over stored values of the same dimension and rep as Q but in a different unit.
+  // Values are converted to Q on access.
+
+  template<Quantity Q>
+  class converting_quantity_view {
+    using rep = Q::rep;
+
+    const rep* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::int64_t num_ = 1;
+    std::int64_t den_ = 1;
+
+  public:
+    converting_quantity_view() = default;
+    converting_quantity_view(const rep* data, std::size_t size, std::int64_t num, std::int64_t den) noexcept :
+        data_(data), size_(size), num_(num), den_(den)
+    {
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] const rep* raw_data() const noexcept { return data_; }
+
+    [[nodiscard]] Q operator[](std::size_t i) const
+    {
+      Expects(i < size_);
+      return convert(data_[i]);
+    }
+
+    // bulk conversion of [offset, offset + out.size())
+    void copy_to(quantity_span<Q> out, std::size_t offset = 0) const
+    {
+      Expects(offset <= size_ && out.size() <= size_ - offset);
+      Q* o = out.data();
+      const rep* in = data_ + offset;
+      for (std::size_t i = 0; i < out.size(); ++i) o[i] = convert(in[i]);
+    }
+
+  private:
+    [[nodiscard]] Q convert(rep v) const noexcept
+    {
+      if constexpr (treat_as_floating_point<rep>)
+        return Q(static_cast<rep>(v * static_cast<rep>(num_) / static_cast<rep>(den_)));
+      else
+        return Q(static_cast<rep>(static_cast<std::intmax_t>(v) * num_ / den_));
+    }
+  };
+
+#ifdef UNITS_HAS_MMAP
+
+  // mapped_quantity_file
+  //
+  // Read-only memory mapping of a file written with write_quantities. The stored values are
+  // exposed without copying when their type matches the requested quantity exactly.
+
+  class mapped_quantity_file {
+    void* address_ = nullptr;
+    std::size_t length_ = 0;
+
+    [[nodiscard]] const char* bytes() const noexcept { return static_cast<const char*>(address_); }
+
+  public:
+    explicit mapped_quantity_file(const std::string& path)
+    {
+      const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0) throw std::system_error(errno, std::generic_category(), "units: cannot open '" + path + "'");
+      struct stat st;
+      if (::fstat(fd, &st) != 0) {
+        const int err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), "units: cannot stat '" + path + "'");
+      }
+      length_ = static_cast<std::size_t>(st.st_size);
+      if (length_ > 0) {
+        address_ = ::mmap(nullptr, length_, PROT_READ, MAP_SHARED, fd, 0);
+        if (address_ == MAP_FAILED) {
+          const int err = errno;
+          ::close(fd);
+          address_ = nullptr;
+          throw std::system_error(err, std::generic_category(), "units: cannot map '" + path + "'");
+        }
+      }
+      ::close(fd);
+      try {
+        validate();
+      }
+      catch (...) {
+        unmap();
+        throw;
+      }
+    }
+
+    mapped_quantity_file(mapped_quantity_file&& other) noexcept :
+        address_(std::exchange(other.address_, nullptr)), length_(std::exchange(other.length_, 0))
+    {
+    }
+
+    mapped_quantity_file& operator=(mapped_quantity_file&& other) noexcept
+    {
+      if (this != &other) {
+        unmap();
+        address_ = std::exchange(other.address_, nullptr);
+        length_ = std::exchange(other.length_, 0);
+      }
+      return *this;
+    }
+
+    ~mapped_quantity_file() { unmap(); }
+
+    [[nodiscard]] const quantity_file_header& header() const noexcept
+    {
+      return *reinterpret_cast<const quantity_file_header*>(address_);
+    }
+
+    [[nodiscard]] const quantity_metadata& metadata() const noexcept { return header().metadata; }
+    [[nodiscard]] std::size_t size() const noexcept { return static_cast<std::size_t>(header().count); }
+
+    // true if the values can be viewed as Q without conversion
+    template<Quantity Q>
+    [[nodiscard]] bool holds() const noexcept
+    {
+      return metadata() == make_quantity_metadata<Q>();
+    }
+
+    // zero-copy view; throws std::runtime_error if the stored type is not exactly Q
+    template<Quantity Q>
+    [[nodiscard]] quantity_span<const Q> view() const
+    {
+      if (!holds<Q>()) throw std::runtime_error("units::mapped_quantity_file: stored quantity type mismatch");
+      return quantity_span<const Q>(data<typename Q::rep>(), size());
+    }
+
+    // view converting lazily to the unit of Q; throws std::runtime_error if the dimension or the rep differ
+    template<Quantity Q>
+    [[nodiscard]] converting_quantity_view<Q> read() const
+    {
+      constexpr quantity_metadata requested = make_quantity_metadata<Q>();
+      if (!metadata().is_convertible_to(requested))
+        throw std::runtime_error("units::mapped_quantity_file: stored dimension or rep mismatch");
+      const auto [num, den] = detail::conversion_ratio(metadata(), requested);
+      return converting_quantity_view<Q>(data<typename Q::rep>(), size(), num, den);
+    }
+
+  private:
+    template<typename Rep>
+    [[nodiscard]] const Rep* data() const noexcept
+    {
+      return reinterpret_cast<const Rep*>(bytes() + header().data_offset);
+    }
+
+    void validate() const
+    {
+      if (length_ < sizeof(quantity_file_header))
+        throw std::runtime_error("units::mapped_quantity_file: file too small");
+      const quantity_file_header& h = header();
+      if (!std::equal(std::begin(h.magic), std::end(h.magic), std::begin(h.magic_value)))
+        throw std::runtime_error("units::mapped_quantity_file: not a quantity file");
+      if (h.version != quantity_file_header::current_version)
+        throw std::runtime_error("units::mapped_quantity_file: unsupported version");
+      if (h.byte_order != quantity_file_header::byte_order_mark)
+        throw std::runtime_error("units::mapped_quantity_file: unsupported byte order");
+      if (h.metadata.rep_size == 0 || h.data_offset % h.metadata.rep_size != 0 || h.data_offset > length_ ||
+          h.count > (length_ - h.data_offset) / h.metadata.rep_size)
+        throw std::runtime_error("units::mapped_quantity_file: truncated file");
+    }
+
+    void unmap() noexcept
+    {
+      if (address_ != nullptr) ::munmap(address_, length_);
+      address_ = nullptr;
+      length_ = 0;
+    }
+  };
+
+#endif  // UNITS_HAS_MMAP
+
+}  // namespace units
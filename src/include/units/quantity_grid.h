@@ -0,0 +1,253 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/dimension.h>
+#include <units/length.h>
+#include <units/quantity_span.h>
+#include <units/thread_pool.h>
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace units {
+
+  // quantity_grid_view
+  //
+  // Non-owning mdspan-style view over a row-major 2D field of quantities. Rows may be padded
+  // (stride >= cols) so a view can also refer to a sub-block of a bigger field.
+
+  template<typename Q>
+      requires Quantity<std::remove_const_t<Q>>
+  class quantity_grid_view {
+  public:
+    using element_type = Q;
+    using value_type = std::remove_const_t<Q>;
+
+  private:
+    Q* data_ = nullptr;
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    std::size_t stride_ = 0;
+
+  public:
+    constexpr quantity_grid_view() noexcept = default;
+    constexpr quantity_grid_view(Q* data, std::size_t rows, std::size_t cols) noexcept :
+        quantity_grid_view(data, rows, cols, cols)
+    {
+    }
+    constexpr quantity_grid_view(Q* data, std::size_t rows, std::size_t cols, std::size_t stride) :
+        data_(data), rows_(rows), cols_(cols), stride_(stride)
+    {
+      Expects(stride >= cols);
+    }
+
+    // quantity_grid_view<Q> -> quantity_grid_view<const Q>
+    template<typename Q2>
+        requires std::is_same_v<const Q2, Q> && (!std::is_same_v<Q2, Q>)
+    constexpr quantity_grid_view(const quantity_grid_view<Q2>& other) noexcept :
+        data_(other.data()), rows_(other.rows()), cols_(other.cols()), stride_(other.stride())
+    {
+    }
+
+    [[nodiscard]] constexpr Q* data() const noexcept { return data_; }
+    [[nodiscard]] constexpr std::size_t rows() const noexcept { return rows_; }
+    [[nodiscard]] constexpr std::size_t cols() const noexcept { return cols_; }
+    [[nodiscard]] constexpr std::size_t stride() const noexcept { return stride_; }
+    [[nodiscard]] constexpr std::size_t extent(std::size_t r) const noexcept { return r == 0 ? rows_ : cols_; }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return rows_ * cols_; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+
+    [[nodiscard]] constexpr Q& operator()(std::size_t row, std::size_t col) const
+    {
+      Expects(row < rows_ && col < cols_);
+      return data_[row * stride_ + col];
+    }
+
+    [[nodiscard]] constexpr quantity_span<Q> row(std::size_t r) const
+    {
+      Expects(r < rows_);
+      return quantity_span<Q>(data_ + r * stride_, cols_);
+    }
+
+    [[nodiscard]] constexpr quantity_grid_view subgrid(std::size_t row, std::size_t col, std::size_t rows,
+                                                       std::size_t cols) const
+    {
+      Expects(row <= rows_ && rows <= rows_ - row && col <= cols_ && cols <= cols_ - col);
+      return quantity_grid_view(data_ + row * stride_ + col, rows, cols, stride_);
+    }
+  };
+
+  // quantity_grid
+  //
+  // Owning, contiguous row-major 2D field of quantities.
+
+  template<Quantity Q>
+  class quantity_grid {
+    std::vector<Q> data_;
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+
+  public:
+    using value_type = Q;
+
+    quantity_grid() = default;
+    quantity_grid(std::size_t rows, std::size_t cols, const Q& value = Q(quantity_values<typename Q::rep>::zero())) :
+        data_(rows * cols, value), rows_(rows), cols_(cols)
+    {
+    }
+
+    [[nodiscard]] std::size_t rows() const noexcept { return rows_; }
+    [[nodiscard]] std::size_t cols() const noexcept { return cols_; }
+    [[nodiscard]] std::size_t size() const noexcept { return data_.size(); }
+    [[nodiscard]] Q* data() noexcept { return data_.data(); }
+    [[nodiscard]] const Q* data() const noexcept { return data_.data(); }
+
+    [[nodiscard]] Q& operator()(std::size_t row, std::size_t col) { return view()(row, col); }
+    [[nodiscard]] const Q& operator()(std::size_t row, std::size_t col) const { return view()(row, col); }
+
+    [[nodiscard]] quantity_grid_view<Q> view() noexcept { return quantity_grid_view<Q>(data_.data(), rows_, cols_); }
+    [[nodiscard]] quantity_grid_view<const Q> view() const noexcept
+    {
+      return quantity_grid_view<const Q>(data_.data(), rows_, cols_);
+    }
+
+    operator quantity_grid_view<Q>() noexcept { return view(); }
+    operator quantity_grid_view<const Q>() const noexcept { return view(); }
+  };
+
+  // Result types of the differential kernels for a field Q sampled with a spacing L
+
+  template<Quantity Q, Length L>
+  using gradient_t = decltype(std::declval<Q>() / std::declval<L>());
+
+  template<Quantity Q, Length L>
+  using laplacian_t = decltype(std::declval<Q>() / (std::declval<L>() * std::declval<L>()));
+
+  namespace detail {
+
+    // Columns processed at once for all the rows of a band. Three input rows and one output row
+    // of a block of doubles fit in L1 data cache.
+    inline constexpr std::size_t stencil_block_cols = 1024;
+
+    // Calls f(i, j_first, j_last) for every interior row of the grid in cache sized column blocks.
+    // The interior rows are split between the threads of the pool if one is provided.
+    template<typename F>
+    void for_each_interior_block(std::size_t rows, std::size_t cols, thread_pool* pool, F f)
+    {
+      if (rows < 3 || cols < 3) return;
+      const auto band = [&](std::size_t first_row, std::size_t last_row) {
+        for (std::size_t j0 = 1; j0 < cols - 1; j0 += stencil_block_cols) {
+          const std::size_t j1 = std::min(j0 + stencil_block_cols, cols - 1);
+          for (std::size_t i = first_row; i < last_row; ++i) f(i, j0, j1);
+        }
+      };
+      if (pool != nullptr)
+        pool->parallel_for(1, rows - 1, band);
+      else
+        band(1, rows - 1);
+    }
+
+    // Spacing converted to the representation of the field so that its inverse is not computed in
+    // integer arithmetic for an integral spacing
+    template<typename In, Length L>
+    [[nodiscard]] constexpr auto spacing_as(const L& d)
+    {
+      return quantity_cast<quantity<typename L::dimension, typename L::unit, typename std::remove_const_t<In>::rep>>(d);
+    }
+
+  }  // namespace detail
+
+  // apply_stencil
+  //
+  // 5-point stencil: out(i, j) = kernel(center, north, south, west, east) for every interior
+  // point of the grid. Boundary cells of out are left untouched. The rows are split between the
+  // threads of the pool when one is given.
+
+  template<typename In, typename Out, typename Kernel>
+      requires (!std::is_const_v<Out>) &&
+               std::is_convertible_v<std::invoke_result_t<Kernel&, In&, In&, In&, In&, In&>, Out>
+  void apply_stencil(quantity_grid_view<In> in, quantity_grid_view<Out> out, Kernel kernel, thread_pool* pool = nullptr)
+  {
+    Expects(in.rows() == out.rows() && in.cols() == out.cols());
+    detail::for_each_interior_block(in.rows(), in.cols(), pool, [&](std::size_t i, std::size_t j0, std::size_t j1) {
+      In* c = in.data() + i * in.stride();
+      In* n = c - in.stride();
+      In* s = c + in.stride();
+      Out* o = out.data() + i * out.stride();
+      for (std::size_t j = j0; j < j1; ++j) o[j] = kernel(c[j], n[j], s[j], c[j - 1], c[j + 1]);
+    });
+  }
+
+  // gradient
+  //
+  // Central differences of the field along columns (x, spacing dx) and rows (y, spacing dy)
+  // for every interior point. Boundary cells of gx and gy are left untouched.
+
+  template<typename In, Length L, typename GX, typename GY>
+      requires treat_as_floating_point<typename std::remove_const_t<In>::rep> &&
+               (!std::is_const_v<GX>) && (!std::is_const_v<GY>) &&
+               std::Same<typename GX::dimension, dimension_divide_t<typename In::dimension, typename L::dimension>> &&
+               std::Same<typename GY::dimension, dimension_divide_t<typename In::dimension, typename L::dimension>>
+  void gradient(quantity_grid_view<In> in, const L& dx, const L& dy, quantity_grid_view<GX> gx,
+                quantity_grid_view<GY> gy, thread_pool* pool = nullptr)
+  {
+    Expects(in.rows() == gx.rows() && in.cols() == gx.cols());
+    Expects(in.rows() == gy.rows() && in.cols() == gy.cols());
+    const auto inv_2dx = 1 / (2 * detail::spacing_as<In>(dx));
+    const auto inv_2dy = 1 / (2 * detail::spacing_as<In>(dy));
+    detail::for_each_interior_block(in.rows(), in.cols(), pool, [&](std::size_t i, std::size_t j0, std::size_t j1) {
+      In* c = in.data() + i * in.stride();
+      In* n = c - in.stride();
+      In* s = c + in.stride();
+      GX* ox = gx.data() + i * gx.stride();
+      GY* oy = gy.data() + i * gy.stride();
+      for (std::size_t j = j0; j < j1; ++j) {
+        ox[j] = (c[j + 1] - c[j - 1]) * inv_2dx;
+        oy[j] = (s[j] - n[j]) * inv_2dy;
+      }
+    });
+  }
+
+  // laplacian
+  //
+  // 5-point finite difference Laplacian for every interior point. Boundary cells of out are left untouched.
+
+  template<typename In, Length L, typename Out>
+      requires treat_as_floating_point<typename std::remove_const_t<In>::rep> && (!std::is_const_v<Out>) &&
+               std::Same<typename Out::dimension,
+                         dimension_divide_t<typename In::dimension, dimension_multiply_t<typename L::dimension,
+                                                                                         typename L::dimension>>>
+  void laplacian(quantity_grid_view<In> in, const L& dx, const L& dy, quantity_grid_view<Out> out,
+                 thread_pool* pool = nullptr)
+  {
+    const auto inv_dx2 = 1 / (detail::spacing_as<In>(dx) * detail::spacing_as<In>(dx));
+    const auto inv_dy2 = 1 / (detail::spacing_as<In>(dy) * detail::spacing_as<In>(dy));
+    apply_stencil(in, out, [&](const auto& c, const auto& n, const auto& s, const auto& w, const auto& e) {
+      return (w - 2 * c + e) * inv_dx2 + (n - 2 * c + s) * inv_dy2;
+    }, pool);
+  }
+
+}  // namespace units
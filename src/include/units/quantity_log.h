@@ -0,0 +1,486 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/charconv.h>
+#include <units/bits/concurrency.h>
+#include <units/quantity_file.h>
+#include <units/unit_registry.h>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <iterator>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace units {
+
+  // log_format
+  //
+  // Format string of log records registered once in a process-wide table. Records refer to it by
+  // its id only. The first "{}" is replaced with the value and the unit symbol when decoded.
+  // The text has to outlive the logging (a string literal in practice):
+  //
+  //   static const units::log_format speed_format("speed: {}");
+  //   logger.log(speed_format, v);
+
+  class log_format {
+    struct table {
+      std::mutex mutex;
+      std::vector<std::string_view> formats;
+    };
+
+    static table& formats() noexcept
+    {
+      static table t;
+      return t;
+    }
+
+    std::uint16_t id_;
+    std::string_view text_;
+
+  public:
+    explicit log_format(std::string_view text) : text_(text)
+    {
+      table& t = formats();
+      std::lock_guard lock(t.mutex);
+      if (t.formats.size() > 0xFFFF) throw std::length_error("units::log_format: too many formats");
+      id_ = static_cast<std::uint16_t>(t.formats.size());
+      t.formats.push_back(text);
+    }
+
+    log_format(const log_format&) = delete;
+    log_format& operator=(const log_format&) = delete;
+
+    [[nodiscard]] std::uint16_t id() const noexcept { return id_; }
+    [[nodiscard]] std::string_view text() const noexcept { return text_; }
+
+    // formats with ids in [first, size()) registered so far
+    [[nodiscard]] static std::vector<std::string_view> registered(std::size_t first = 0)
+    {
+      table& t = formats();
+      std::lock_guard lock(t.mutex);
+      return first < t.formats.size() ? std::vector<std::string_view>(t.formats.begin() + first, t.formats.end())
+                                      : std::vector<std::string_view>();
+    }
+  };
+
+  // log_record
+
+  struct log_record {
+    std::uint64_t bits;  // bit pattern of the rep
+    std::uint16_t format;
+    unit_id unit;
+    rep_kind kind;
+    std::uint8_t rep_size;
+    std::uint16_t thread;
+  };
+
+  static_assert(sizeof(log_record) == 16);
+  static_assert(std::is_trivially_copyable_v<log_record>);
+
+  // Loggable
+
+  template<typename Q>
+  concept bool Loggable =
+      Quantity<Q> && unit_registry::contains<typename Q::unit> && std::is_arithmetic_v<typename Q::rep> &&
+      sizeof(typename Q::rep) <= sizeof(std::uint64_t);
+
+  namespace detail {
+
+    // Bounded single producer single consumer queue
+    template<typename T>
+    class spsc_ring {
+      std::unique_ptr<T[]> buffer_;
+      std::size_t mask_;
+      alignas(cache_line_size) std::atomic<std::size_t> tail_{0};  // written by the producer
+      std::size_t cached_head_ = 0;                                 // producer's copy of head_
+      alignas(cache_line_size) std::atomic<std::size_t> head_{0};  // written by the consumer
+
+    public:
+      explicit spsc_ring(std::size_t capacity) noexcept :
+          buffer_(new (std::nothrow) T[shard_count(capacity)]), mask_(shard_count(capacity) - 1)
+      {
+      }
+
+      // false if the buffer could not be allocated
+      [[nodiscard]] bool valid() const noexcept { return buffer_ != nullptr; }
+
+      [[nodiscard]] bool try_push(const T& value) noexcept
+      {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+          cached_head_ = head_.load(std::memory_order_acquire);
+          if (tail - cached_head_ > mask_) return false;
+        }
+        buffer_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+      }
+
+      // calls f(first, count) for the contiguous parts of the queued values and pops them
+      template<typename F>
+      std::size_t drain(F&& f)
+      {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        const std::size_t first = head & mask_;
+        const std::size_t count = tail - head;
+        const std::size_t part = std::min(count, mask_ + 1 - first);
+        if (part > 0) f(&buffer_[first], part);
+        if (count > part) f(&buffer_[0], count - part);
+        head_.store(tail, std::memory_order_release);
+        return count;
+      }
+    };
+
+    inline constexpr char log_magic[8] = {'U', 'N', 'I', 'T', 'S', 'L', 'O', 'G'};
+    inline constexpr std::uint32_t log_version = 1;
+    inline constexpr std::uint32_t log_byte_order = 0x01020304;
+
+    // chunk tags of a segment of the log stream
+    enum class log_chunk : std::uint8_t { unit = 'U', format = 'F', records = 'R', end = 'E' };
+
+    template<typename T>
+    void write_raw(std::ostream& os, const T& value)
+    {
+      os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    inline void write_string(std::ostream& os, std::string_view s)
+    {
+      write_raw(os, static_cast<std::uint16_t>(s.size()));
+      os.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+
+  }  // namespace detail
+
+  // quantity_logger
+  //
+  // Binary log sink of quantities. Every thread appends fixed size records (the raw bits of the rep,
+  // the id of the unit in the unit_registry and the id of the format) to its own lock-free ring
+  // buffer, so logging is a few stores with no formatting and no contention. A single consumer
+  // periodically calls write() to move the records to a stream that is rendered offline with
+  // decode_log().
+  //
+  // A thread takes one of max_threads slots on its first record and gives it back when it exits, so
+  // only the threads logging at the same time are limited. Records are dropped (and counted) when a
+  // ring is full, when no slot is free or when a ring cannot be allocated. log() never throws.
+
+  class quantity_logger {
+    using ring = detail::spsc_ring<log_record>;
+
+    // Slots shared with the threads that hold one of them, so that a thread exiting after the
+    // logger was destroyed can still give its slot back
+    struct slots {
+      std::size_t ring_capacity;
+      std::size_t count;
+      std::unique_ptr<std::atomic<ring*>[]> rings;
+      std::unique_ptr<std::atomic<bool>[]> owned;
+      std::atomic<bool> closed{false};
+
+      slots(std::size_t capacity, std::size_t max_threads) :
+          ring_capacity(capacity), count(max_threads), rings(new std::atomic<ring*>[max_threads]),
+          owned(new std::atomic<bool>[max_threads])
+      {
+        for (std::size_t i = 0; i < count; ++i) {
+          rings[i].store(nullptr, std::memory_order_relaxed);
+          owned[i].store(false, std::memory_order_relaxed);
+        }
+      }
+
+      ~slots()
+      {
+        for (std::size_t i = 0; i < count; ++i) delete rings[i].load(std::memory_order_relaxed);
+      }
+    };
+
+    struct lease {
+      std::shared_ptr<slots> owner;
+      std::size_t slot;
+      ring* r;
+    };
+
+    // slots held by the calling thread in all the loggers, given back when the thread exits
+    struct thread_leases {
+      std::vector<lease> leases;
+
+      ~thread_leases()
+      {
+        for (const lease& l : leases) l.owner->owned[l.slot].store(false, std::memory_order_release);
+      }
+    };
+
+    std::shared_ptr<slots> slots_;
+    detail::cache_line_padded<std::atomic<std::uint64_t>> dropped_{0};
+    std::vector<log_record> pending_;
+
+    static std::vector<lease>& thread_slots() noexcept
+    {
+      thread_local thread_leases l;
+      return l.leases;
+    }
+
+    const lease* local() noexcept
+    {
+      std::vector<lease>& leases = thread_slots();
+      for (const lease& l : leases)
+        if (l.owner == slots_) return &l;
+
+      // first record of this thread in this logger
+      const auto stale = std::remove_if(leases.begin(), leases.end(), [](const lease& l) {
+        if (!l.owner->closed.load(std::memory_order_relaxed)) return false;
+        l.owner->owned[l.slot].store(false, std::memory_order_release);
+        return true;
+      });
+      leases.erase(stale, leases.end());
+      try {
+        leases.reserve(leases.size() + 1);
+      }
+      catch (...) {
+        return nullptr;
+      }
+
+      slots& s = *slots_;
+      for (std::size_t i = 0; i < s.count; ++i) {
+        bool expected = false;
+        if (s.owned[i].load(std::memory_order_relaxed) ||
+            !s.owned[i].compare_exchange_strong(expected, true, std::memory_order_acquire))
+          continue;
+        // the ring of a slot is created by its first owner and reused by the next ones
+        ring* r = s.rings[i].load(std::memory_order_acquire);
+        if (r == nullptr) {
+          r = new (std::nothrow) ring(s.ring_capacity);
+          if (r != nullptr && !r->valid()) {
+            delete r;
+            r = nullptr;
+          }
+          if (r == nullptr) {
+            s.owned[i].store(false, std::memory_order_release);
+            return nullptr;
+          }
+          s.rings[i].store(r, std::memory_order_release);
+        }
+        leases.push_back({slots_, i, r});
+        return &leases.back();
+      }
+      return nullptr;
+    }
+
+    static void write_header(std::ostream& os)
+    {
+      os.write(detail::log_magic, sizeof(detail::log_magic));
+      detail::write_raw(os, detail::log_version);
+      detail::write_raw(os, detail::log_byte_order);
+      for (unit_id id = 0; id < unit_registry::size; ++id) {
+        detail::write_raw(os, detail::log_chunk::unit);
+        detail::write_raw(os, id);
+        detail::write_string(os, unit_registry::symbols[id]);
+      }
+    }
+
+  public:
+    explicit quantity_logger(std::size_t ring_capacity = 4096, std::size_t max_threads = 64) :
+        slots_(std::make_shared<slots>(ring_capacity, max_threads))
+    {
+    }
+
+    ~quantity_logger() { slots_->closed.store(true, std::memory_order_relaxed); }
+
+    quantity_logger(const quantity_logger&) = delete;
+    quantity_logger& operator=(const quantity_logger&) = delete;
+
+    // number of the records dropped so far
+    [[nodiscard]] std::uint64_t dropped() const noexcept { return dropped_.value.load(std::memory_order_relaxed); }
+
+    template<Loggable Q>
+    bool log(const log_format& format, const Q& q) noexcept
+    {
+      const lease* l = local();
+      if (l != nullptr) {
+        const auto md = make_quantity_metadata<Q>();
+        const log_record record{detail::to_bits(q.count()), format.id(), unit_id_of<typename Q::unit>, md.kind,
+                                md.rep_size, static_cast<std::uint16_t>(l->slot)};
+        if (l->r->try_push(record)) return true;
+      }
+      dropped_.value.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    // Moves the queued records to the stream as a self-contained segment with the unit symbols and
+    // all the formats registered so far, so the output of every call can be decoded on its own (i.e.
+    // after rotating the log file) as well as concatenated with the others. Must not be called
+    // concurrently with itself. Returns the number of records.
+    std::size_t write(std::ostream& os)
+    {
+      pending_.clear();
+      for (std::size_t i = 0; i < slots_->count; ++i) {
+        ring* r = slots_->rings[i].load(std::memory_order_acquire);
+        if (r == nullptr) continue;
+        r->drain([&](const log_record* first, std::size_t count) {
+          pending_.insert(pending_.end(), first, first + count);
+        });
+      }
+
+      // the formats are listed after draining so that they include the ones used by the records
+      write_header(os);
+      const std::vector<std::string_view> formats = log_format::registered();
+      for (std::size_t id = 0; id < formats.size(); ++id) {
+        detail::write_raw(os, detail::log_chunk::format);
+        detail::write_raw(os, static_cast<std::uint16_t>(id));
+        detail::write_string(os, formats[id]);
+      }
+      for (std::size_t first = 0; first < pending_.size();) {
+        const std::size_t count = std::min<std::size_t>(pending_.size() - first, 0xFFFF'FFFF);
+        detail::write_raw(os, detail::log_chunk::records);
+        detail::write_raw(os, static_cast<std::uint32_t>(count));
+        os.write(reinterpret_cast<const char*>(pending_.data() + first),
+                 static_cast<std::streamsize>(count * sizeof(log_record)));
+        first += count;
+      }
+      detail::write_raw(os, detail::log_chunk::end);
+      if (!os) throw std::runtime_error("units::quantity_logger: write failed");
+      return pending_.size();
+    }
+  };
+
+  namespace detail {
+
+    template<typename T>
+    void read_raw(std::istream& is, T& value)
+    {
+      if (!is.read(reinterpret_cast<char*>(&value), sizeof(T)))
+        throw std::runtime_error("units::decode_log: truncated log");
+    }
+
+    inline std::string read_string(std::istream& is)
+    {
+      std::uint16_t size;
+      read_raw(is, size);
+      std::string s(size, '\0');
+      if (!is.read(s.data(), size)) throw std::runtime_error("units::decode_log: truncated log");
+      return s;
+    }
+
+    inline void append_log_value(std::string& out, const log_record& r)
+    {
+      char buffer[32];
+      std::to_chars_result res;
+      if (r.kind == rep_kind::floating_point && r.rep_size == sizeof(float)) {
+        float v;
+        const auto bits = static_cast<std::uint32_t>(r.bits);
+        std::memcpy(&v, &bits, sizeof(v));
+        res = number_to_chars(std::begin(buffer), std::end(buffer), v);
+      }
+      else if (r.kind == rep_kind::floating_point) {
+        double v;
+        std::memcpy(&v, &r.bits, sizeof(v));
+        res = number_to_chars(std::begin(buffer), std::end(buffer), v);
+      }
+      else if (r.kind == rep_kind::signed_integer)
+        res = number_to_chars(std::begin(buffer), std::end(buffer), static_cast<std::int64_t>(r.bits));
+      else
+        res = number_to_chars(std::begin(buffer), std::end(buffer), r.bits);
+      out.append(buffer, res.ptr);
+    }
+
+  }  // namespace detail
+
+  // decode_log
+  //
+  // Renders a binary log written by quantity_logger as text, one record per line prefixed with the
+  // slot of the logging thread. The log is a sequence of segments written by quantity_logger::write().
+  // Throws std::runtime_error on a malformed log.
+
+  inline std::size_t decode_log(std::istream& is, std::ostream& os)
+  {
+    std::size_t count = 0;
+    std::vector<std::string> symbols, formats;
+    std::string line;
+    while (is.peek() != std::istream::traits_type::eof()) {
+      char magic[sizeof(detail::log_magic)];
+      std::uint32_t version, byte_order;
+      if (!is.read(magic, sizeof(magic)) || std::memcmp(magic, detail::log_magic, sizeof(magic)) != 0)
+        throw std::runtime_error("units::decode_log: not a quantity log");
+      detail::read_raw(is, version);
+      detail::read_raw(is, byte_order);
+      if (version != detail::log_version || byte_order != detail::log_byte_order)
+        throw std::runtime_error("units::decode_log: unsupported version or byte order");
+
+      symbols.clear();
+      formats.clear();
+      auto store = [](std::vector<std::string>& v, std::uint16_t id, std::string s) {
+        if (id >= v.size()) v.resize(id + 1);
+        v[id] = std::move(s);
+      };
+      detail::log_chunk tag;
+      do {
+        detail::read_raw(is, tag);
+        switch (tag) {
+          case detail::log_chunk::unit:
+          case detail::log_chunk::format: {
+            std::uint16_t id;
+            detail::read_raw(is, id);
+            store(tag == detail::log_chunk::unit ? symbols : formats, id, detail::read_string(is));
+            break;
+          }
+          case detail::log_chunk::records: {
+            std::uint32_t n;
+            detail::read_raw(is, n);
+            for (std::uint32_t i = 0; i < n; ++i, ++count) {
+              log_record r;
+              detail::read_raw(is, r);
+              if (r.unit >= symbols.size() || r.format >= formats.size())
+                throw std::runtime_error("units::decode_log: unknown unit or format id");
+              const std::string& format = formats[r.format];
+              const std::size_t placeholder = std::min(format.find("{}"), format.size());
+              line.assign("[").append(std::to_string(r.thread)).append("] ").append(format, 0, placeholder);
+              detail::append_log_value(line, r);
+              if (!symbols[r.unit].empty()) line.append(" ").append(symbols[r.unit]);
+              if (placeholder < format.size()) line.append(format, placeholder + 2);
+              os << line << '\n';
+            }
+            break;
+          }
+          case detail::log_chunk::end:
+            break;
+          default:
+            throw std::runtime_error("units::decode_log: malformed log");
+        }
+      } while (tag != detail::log_chunk::end);
+    }
+    return count;
+  }
+
+}  // namespace units
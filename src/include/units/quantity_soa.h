@@ -0,0 +1,203 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/quantity_span.h>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace units {
+
+  // quantity_soa
+  //
+  // Struct-of-arrays storage of records made of several quantities. Every field is stored in its
+  // own contiguous column so kernels touching only some of the fields do not waste cache lines
+  // on the others. Columns are exposed as quantity_span and rows as lightweight proxies.
+
+  template<Quantity... Qs>
+  class quantity_soa {
+  public:
+    using row_type = std::tuple<Qs...>;
+    using size_type = std::size_t;
+
+    template<std::size_t I>
+    using column_type = std::tuple_element_t<I, row_type>;
+
+    static constexpr std::size_t columns = sizeof...(Qs);
+
+  private:
+    std::tuple<std::vector<Qs>...> columns_;
+
+    template<typename Soa>
+    class row_proxy {
+      Soa* soa_;
+      std::size_t index_;
+
+      template<std::size_t... Is>
+      row_type load(std::index_sequence<Is...>) const
+      {
+        return row_type(get<Is>()...);
+      }
+
+      template<std::size_t... Is>
+      void store(const row_type& row, std::index_sequence<Is...>) const
+      {
+        ((get<Is>() = std::get<Is>(row)), ...);
+      }
+
+    public:
+      row_proxy(Soa& soa, std::size_t index) noexcept : soa_(&soa), index_(index) {}
+
+      template<std::size_t I>
+      [[nodiscard]] auto& get() const
+      {
+        return std::get<I>(soa_->columns_)[index_];
+      }
+
+      [[nodiscard]] std::size_t index() const noexcept { return index_; }
+
+      operator row_type() const { return load(std::index_sequence_for<Qs...>()); }
+
+      const row_proxy& operator=(const row_type& row) const requires(!std::is_const_v<Soa>)
+      {
+        store(row, std::index_sequence_for<Qs...>());
+        return *this;
+      }
+    };
+
+  public:
+    using reference = row_proxy<quantity_soa>;
+    using const_reference = row_proxy<const quantity_soa>;
+
+    quantity_soa() = default;
+    explicit quantity_soa(std::size_t size) { resize(size); }
+
+    [[nodiscard]] std::size_t size() const noexcept { return std::get<0>(columns_).size(); }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return std::get<0>(columns_).capacity(); }
+
+    void reserve(std::size_t n)
+    {
+      std::apply([n](auto&... c) { (c.reserve(n), ...); }, columns_);
+    }
+
+    void resize(std::size_t n)
+    {
+      std::apply([n](auto&... c) { (c.resize(n), ...); }, columns_);
+    }
+
+    void clear() noexcept
+    {
+      std::apply([](auto&... c) { (c.clear(), ...); }, columns_);
+    }
+
+    void push_back(const Qs&... values)
+    {
+      push_back_impl(std::index_sequence_for<Qs...>(), values...);
+    }
+
+    void push_back(const row_type& row)
+    {
+      std::apply([this](const Qs&... values) { push_back(values...); }, row);
+    }
+
+    void pop_back()
+    {
+      Expects(!empty());
+      std::apply([](auto&... c) { (c.pop_back(), ...); }, columns_);
+    }
+
+    [[nodiscard]] reference operator[](std::size_t i)
+    {
+      Expects(i < size());
+      return reference(*this, i);
+    }
+
+    [[nodiscard]] const_reference operator[](std::size_t i) const
+    {
+      Expects(i < size());
+      return const_reference(*this, i);
+    }
+
+    template<std::size_t I>
+    [[nodiscard]] quantity_span<column_type<I>> column() noexcept
+    {
+      auto& c = std::get<I>(columns_);
+      return quantity_span<column_type<I>>(c.data(), c.size());
+    }
+
+    template<std::size_t I>
+    [[nodiscard]] quantity_span<const column_type<I>> column() const noexcept
+    {
+      const auto& c = std::get<I>(columns_);
+      return quantity_span<const column_type<I>>(c.data(), c.size());
+    }
+
+  private:
+    template<std::size_t... Is>
+    void push_back_impl(std::index_sequence<Is...>, const Qs&... values)
+    {
+      // strong exception guarantee: roll back the columns that already grew
+      std::size_t pushed = 0;
+      try {
+        ((std::get<Is>(columns_).push_back(values), ++pushed), ...);
+      }
+      catch (...) {
+        ((Is < pushed ? std::get<Is>(columns_).pop_back() : void()), ...);
+        throw;
+      }
+    }
+  };
+
+  // transform_columns
+  //
+  // Applies op element-wise to the input columns. The result dimension follows from the quantity
+  // operators used by op (i.e. length / time gives velocity) and is checked against the output column.
+
+  template<typename Out, typename Op, typename... In>
+      requires Quantity<std::remove_const_t<Out>> && (!std::is_const_v<Out>) &&
+               std::is_convertible_v<std::invoke_result_t<Op&, In&...>, Out>
+  void transform_columns(quantity_span<Out> out, Op op, quantity_span<In>... in)
+  {
+    Expects(((in.size() == out.size()) && ...));
+    Out* o = out.data();
+    const std::size_t n = out.size();
+    for (std::size_t i = 0; i < n; ++i) o[i] = op(in.data()[i]...);
+  }
+
+  template<typename Op, typename... In>
+  [[nodiscard]] auto transform_columns(Op op, quantity_span<In>... in)
+      requires(sizeof...(In) > 0) && Quantity<std::remove_cvref_t<std::invoke_result_t<Op&, In&...>>>
+  {
+    using result = std::remove_cvref_t<std::invoke_result_t<Op&, In&...>>;
+    const std::size_t n = std::get<0>(std::forward_as_tuple(in...)).size();
+    std::vector<result> out(n);
+    transform_columns(quantity_span<result>(out.data(), n), op, in...);
+    return out;
+  }
+
+}  // namespace units
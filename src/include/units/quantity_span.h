@@ -0,0 +1,277 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/quantity.h>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace units {
+
+  namespace detail {
+
+    // A buffer of reps may be viewed as a buffer of quantities only if the quantity is nothing more than its rep
+    template<Quantity Q>
+    inline constexpr bool is_rep_layout_compatible =
+        std::is_standard_layout_v<Q> && std::is_trivially_copyable_v<Q> &&
+        sizeof(Q) == sizeof(typename Q::rep) && alignof(Q) == alignof(typename Q::rep);
+
+  }  // namespace detail
+
+  // quantity_span
+  //
+  // Non-owning view over a contiguous sequence of quantities. It can be created directly over
+  // a buffer of raw reps (i.e. a DMA buffer or a memory mapped file) without copying the data.
+  // Elements are accessed as Q& so all the quantity operators can be used on them.
+
+  template<typename Q>
+      requires Quantity<std::remove_const_t<Q>>
+  class quantity_span {
+  public:
+    using element_type = Q;
+    using value_type = std::remove_const_t<Q>;
+    using rep = conditional<std::is_const_v<Q>, const typename value_type::rep, typename value_type::rep>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Q*;
+    using reference = Q&;
+    using iterator = Q*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    static_assert(detail::is_rep_layout_compatible<value_type>, "quantity must have the same layout as its rep");
+
+  private:
+    Q* data_ = nullptr;
+    std::size_t size_ = 0;
+
+  public:
+    constexpr quantity_span() noexcept = default;
+    constexpr quantity_span(Q* data, std::size_t size) noexcept : data_(data), size_(size) {}
+    quantity_span(rep* data, std::size_t size) noexcept : data_(reinterpret_cast<Q*>(data)), size_(size) {}
+
+    // contiguous range of quantities
+    template<typename R>
+        requires std::is_convertible_v<decltype(std::data(std::declval<R&>())), Q*>
+    constexpr quantity_span(R&& r) noexcept : data_(std::data(r)), size_(std::size(r))
+    {
+    }
+
+    // contiguous range of raw reps (i.e. std::span<Rep>)
+    template<typename R>
+        requires std::is_convertible_v<decltype(std::data(std::declval<R&>())), rep*> &&
+                 (!std::is_convertible_v<decltype(std::data(std::declval<R&>())), Q*>)
+    explicit quantity_span(R&& r) noexcept : quantity_span(std::data(r), std::size(r))
+    {
+    }
+
+    // quantity_span<Q> -> quantity_span<const Q>
+    template<typename Q2>
+        requires std::is_same_v<const Q2, Q> && (!std::is_same_v<Q2, Q>)
+    constexpr quantity_span(const quantity_span<Q2>& other) noexcept : data_(other.data()), size_(other.size())
+    {
+    }
+
+    [[nodiscard]] constexpr Q* data() const noexcept { return data_; }
+    [[nodiscard]] rep* rep_data() const noexcept { return reinterpret_cast<rep*>(data_); }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] constexpr std::size_t size_bytes() const noexcept { return size_ * sizeof(Q); }
+    [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+
+    [[nodiscard]] constexpr Q& operator[](std::size_t i) const
+    {
+      Expects(i < size_);
+      return data_[i];
+    }
+
+    [[nodiscard]] constexpr Q& front() const { return (*this)[0]; }
+    [[nodiscard]] constexpr Q& back() const { return (*this)[size_ - 1]; }
+
+    [[nodiscard]] constexpr iterator begin() const noexcept { return data_; }
+    [[nodiscard]] constexpr iterator end() const noexcept { return data_ + size_; }
+    [[nodiscard]] constexpr reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+    [[nodiscard]] constexpr reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+    [[nodiscard]] constexpr quantity_span first(std::size_t count) const
+    {
+      Expects(count <= size_);
+      return quantity_span(data_, count);
+    }
+
+    [[nodiscard]] constexpr quantity_span last(std::size_t count) const
+    {
+      Expects(count <= size_);
+      return quantity_span(data_ + size_ - count, count);
+    }
+
+    [[nodiscard]] constexpr quantity_span subspan(std::size_t offset, std::size_t count) const
+    {
+      Expects(offset <= size_ && count <= size_ - offset);
+      return quantity_span(data_ + offset, count);
+    }
+  };
+
+  template<Quantity Q>
+  quantity_span(Q*, std::size_t) -> quantity_span<Q>;
+
+  template<Quantity Q>
+  quantity_span(const Q*, std::size_t) -> quantity_span<const Q>;
+
+  // as_quantities
+  //
+  // Views a buffer of raw reps as quantities of type Q.
+
+  template<Quantity Q>
+  [[nodiscard]] quantity_span<Q> as_quantities(typename Q::rep* data, std::size_t size) noexcept
+  {
+    return quantity_span<Q>(data, size);
+  }
+
+  template<Quantity Q>
+  [[nodiscard]] quantity_span<const Q> as_quantities(const typename Q::rep* data, std::size_t size) noexcept
+  {
+    return quantity_span<const Q>(data, size);
+  }
+
+  // converted_quantity_span
+  //
+  // Read-only view over a quantity_span that converts every element to To when it is accessed.
+  // The underlying data is left untouched. Elements are converted like in views::quantity_cast: for
+  // floating-point reps the ratio is folded into one factor, so a result may differ from
+  // quantity_cast in the last bit. Unlike the range adaptor it keeps the size and the O(1) indexing
+  // of the span and does not need the ranges library.
+
+  template<Quantity To, typename From>
+      requires std::Same<typename To::dimension, typename std::remove_const_t<From>::dimension>
+  class converted_quantity_span {
+    using converter = detail::quantity_converter<To, std::remove_const_t<From>>;
+
+    quantity_span<const std::remove_const_t<From>> source_;
+
+  public:
+    using value_type = To;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    class iterator {
+      const std::remove_const_t<From>* ptr_ = nullptr;
+
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = To;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = To;
+
+      constexpr iterator() noexcept = default;
+      constexpr explicit iterator(const std::remove_const_t<From>* ptr) noexcept : ptr_(ptr) {}
+
+      [[nodiscard]] constexpr To operator*() const { return converter{}(*ptr_); }
+      [[nodiscard]] constexpr To operator[](difference_type n) const { return converter{}(ptr_[n]); }
+
+      constexpr iterator& operator++() noexcept
+      {
+        ++ptr_;
+        return *this;
+      }
+
+      constexpr iterator operator++(int) noexcept { return iterator(ptr_++); }
+      constexpr iterator& operator--() noexcept
+      {
+        --ptr_;
+        return *this;
+      }
+
+      constexpr iterator operator--(int) noexcept { return iterator(ptr_--); }
+      constexpr iterator& operator+=(difference_type n) noexcept
+      {
+        ptr_ += n;
+        return *this;
+      }
+
+      constexpr iterator& operator-=(difference_type n) noexcept
+      {
+        ptr_ -= n;
+        return *this;
+      }
+
+      [[nodiscard]] friend constexpr iterator operator+(iterator it, difference_type n) noexcept { return it += n; }
+      [[nodiscard]] friend constexpr iterator operator+(difference_type n, iterator it) noexcept { return it += n; }
+      [[nodiscard]] friend constexpr iterator operator-(iterator it, difference_type n) noexcept { return it -= n; }
+      [[nodiscard]] friend constexpr difference_type operator-(iterator lhs, iterator rhs) noexcept
+      {
+        return lhs.ptr_ - rhs.ptr_;
+      }
+
+      [[nodiscard]] friend constexpr bool operator==(iterator lhs, iterator rhs) noexcept
+      {
+        return lhs.ptr_ == rhs.ptr_;
+      }
+
+      [[nodiscard]] friend constexpr bool operator!=(iterator lhs, iterator rhs) noexcept
+      {
+        return lhs.ptr_ != rhs.ptr_;
+      }
+
+      [[nodiscard]] friend constexpr bool operator<(iterator lhs, iterator rhs) noexcept { return lhs.ptr_ < rhs.ptr_; }
+      [[nodiscard]] friend constexpr bool operator>(iterator lhs, iterator rhs) noexcept { return lhs.ptr_ > rhs.ptr_; }
+      [[nodiscard]] friend constexpr bool operator<=(iterator lhs, iterator rhs) noexcept
+      {
+        return lhs.ptr_ <= rhs.ptr_;
+      }
+
+      [[nodiscard]] friend constexpr bool operator>=(iterator lhs, iterator rhs) noexcept
+      {
+        return lhs.ptr_ >= rhs.ptr_;
+      }
+    };
+
+    constexpr converted_quantity_span() noexcept = default;
+    constexpr explicit converted_quantity_span(quantity_span<From> source) noexcept : source_(source) {}
+
+    [[nodiscard]] constexpr quantity_span<const std::remove_const_t<From>> source() const noexcept { return source_; }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return source_.size(); }
+    [[nodiscard]] constexpr bool empty() const noexcept { return source_.empty(); }
+
+    [[nodiscard]] constexpr To operator[](std::size_t i) const { return converter{}(source_[i]); }
+    [[nodiscard]] constexpr To front() const { return (*this)[0]; }
+    [[nodiscard]] constexpr To back() const { return (*this)[size() - 1]; }
+
+    [[nodiscard]] constexpr iterator begin() const noexcept { return iterator(source_.data()); }
+    [[nodiscard]] constexpr iterator end() const noexcept { return iterator(source_.data() + source_.size()); }
+  };
+
+  // quantity_span_cast
+  //
+  // Lazy view of the elements of the span converted to To. Nothing is converted up front and
+  // the source span is not modified, so it works for spans of const quantities as well.
+
+  template<Quantity To, typename From>
+  [[nodiscard]] constexpr converted_quantity_span<To, From> quantity_span_cast(quantity_span<From> s) noexcept
+      requires std::Same<typename To::dimension, typename std::remove_const_t<From>::dimension>
+  {
+    return converted_quantity_span<To, From>(s);
+  }
+
+}  // namespace units
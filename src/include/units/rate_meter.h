@@ -0,0 +1,163 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/frequency.h>
+#include <units/stopwatch.h>
+#include <units/bits/concurrency.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace units {
+
+  // rate_meter
+  //
+  // Counts events in a sliding time window and reports their rate as a frequency. The window is
+  // divided into a ring of time slots and every thread records into its own set of slots, so
+  // recording is a lock-free update of a thread-local (uncontended) cache line. Each slot keeps
+  // the full epoch it counts for next to the number of events, so a writer can restart a stale slot
+  // without any locking and a reader never mistakes a stale slot for a current one. Reading sums the
+  // slots of all the threads that still belong to the window. The number of slots and shards is
+  // rounded up to a power of 2.
+
+  class rate_meter {
+    using ns = time<nanosecond, std::int64_t>;
+
+    // The epoch is set to `busy` while a writer restarts the slot and the count is read optimistically
+    // between two reads of the epoch (like in a seqlock).
+    struct alignas(detail::cache_line_size) slot {
+      std::atomic<std::uint64_t> epoch{0};
+      std::atomic<std::uint64_t> count{0};
+    };
+
+    static constexpr std::uint64_t busy = std::uint64_t(1) << 63;
+
+    std::uint64_t slot_ns_;
+    std::size_t slots_mask_;
+    std::size_t shards_mask_;
+    std::unique_ptr<slot[]> data_;
+
+    [[nodiscard]] std::uint64_t epoch(const ns& now) const noexcept
+    {
+      return static_cast<std::uint64_t>(now.count()) / slot_ns_;
+    }
+
+    [[nodiscard]] std::size_t slots() const noexcept { return slots_mask_ + 1; }
+
+    [[nodiscard]] slot& at(std::size_t shard, std::size_t s) const noexcept { return data_[shard * slots() + s]; }
+
+    // number of the events of the slot if it still counts for epoch e
+    [[nodiscard]] static std::uint64_t load_count(const slot& s, std::uint64_t e) noexcept
+    {
+      if (s.epoch.load(std::memory_order_acquire) != e) return 0;
+      const std::uint64_t count = s.count.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return s.epoch.load(std::memory_order_relaxed) == e ? count : 0;
+    }
+
+  public:
+    template<Time T>
+    explicit rate_meter(const T& window, std::size_t slots = 16,
+                        std::size_t shards = std::thread::hardware_concurrency())
+        : slot_ns_(1),
+          slots_mask_(detail::shard_count(slots) - 1),
+          shards_mask_(detail::shard_count(shards) - 1),
+          data_(new slot[(slots_mask_ + 1) * (shards_mask_ + 1)])
+    {
+      const auto window_ns = quantity_cast<ns>(window).count();
+      Expects(window_ns > 0);
+      slot_ns_ = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(window_ns) / this->slots());
+    }
+
+    rate_meter(const rate_meter&) = delete;
+    rate_meter& operator=(const rate_meter&) = delete;
+
+    [[nodiscard]] ns window() const noexcept { return ns(static_cast<std::int64_t>(slot_ns_ * slots())); }
+
+    // Events recorded for a time that is already out of the window of another writer sharing the slot
+    // may be lost.
+    template<Time T>
+    void record_at(const T& now, std::uint64_t events = 1) noexcept
+    {
+      const std::uint64_t e = epoch(quantity_cast<ns>(now));
+      slot& s = at(detail::this_thread_index() & shards_mask_, e & slots_mask_);
+      std::uint64_t current = s.epoch.load(std::memory_order_acquire);
+      while (true) {
+        if (current == e) {
+          s.count.fetch_add(events, std::memory_order_relaxed);
+          return;
+        }
+        if (current & busy) {
+          current = s.epoch.load(std::memory_order_acquire);
+          continue;
+        }
+        if (current > e) return;
+        if (s.epoch.compare_exchange_weak(current, e | busy, std::memory_order_acquire)) {
+          std::atomic_thread_fence(std::memory_order_release);
+          s.count.store(events, std::memory_order_relaxed);
+          s.epoch.store(e, std::memory_order_release);
+          return;
+        }
+      }
+    }
+
+    void record(std::uint64_t events = 1) noexcept { record_at(tsc_clock::now(), events); }
+
+    // number of events in the window ending at now
+    template<Time T>
+    [[nodiscard]] std::uint64_t count_at(const T& now) const noexcept
+    {
+      const std::uint64_t e = epoch(quantity_cast<ns>(now));
+      std::uint64_t sum = 0;
+      for (std::size_t i = 0; i < slots(); ++i) {
+        if (e < i) break;
+        const std::uint64_t slot_epoch = e - i;
+        for (std::size_t shard = 0; shard <= shards_mask_; ++shard)
+          sum += load_count(at(shard, slot_epoch & slots_mask_), slot_epoch);
+      }
+      return sum;
+    }
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return count_at(tsc_clock::now()); }
+
+    // The current slot is only partially elapsed so the covered time is the full older slots plus the
+    // elapsed part of the current one.
+    template<Time T>
+    [[nodiscard]] frequency<hertz, double> rate_at(const T& now) const noexcept
+    {
+      const auto now_ns = static_cast<std::uint64_t>(quantity_cast<ns>(now).count());
+      const std::uint64_t e = now_ns / slot_ns_;
+      const std::uint64_t full_slots = std::min<std::uint64_t>(e, slots() - 1);
+      const std::uint64_t covered_ns = full_slots * slot_ns_ + (now_ns - e * slot_ns_) + 1;
+      const time<second, double> covered = time<nanosecond, double>(static_cast<double>(covered_ns));
+      return static_cast<double>(count_at(now)) / covered;
+    }
+
+    [[nodiscard]] frequency<hertz, double> rate() const noexcept { return rate_at(tsc_clock::now()); }
+  };
+
+}  // namespace units
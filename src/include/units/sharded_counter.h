@@ -0,0 +1,95 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/atomic_quantity.h>
+#include <units/bits/concurrency.h>
+#include <memory>
+#include <thread>
+
+namespace units {
+
+  // sharded_counter
+  //
+  // Accumulates a quantity from many threads. Each thread updates its own cache line sized shard
+  // so writes do not contend with each other (as long as there are not more threads than shards).
+  // Reading sums all the shards and converts the result to the requested quantity type.
+
+  template<Quantity Q>
+  class sharded_counter {
+  public:
+    using value_type = Q;
+    using rep = Q::rep;
+
+  private:
+    using shard = detail::cache_line_padded<atomic_quantity<Q>>;
+
+    std::unique_ptr<shard[]> shards_;
+    std::size_t mask_;
+
+    [[nodiscard]] atomic_quantity<Q>& local() noexcept { return shards_[detail::this_thread_index() & mask_].value; }
+
+  public:
+    explicit sharded_counter(std::size_t shards = std::thread::hardware_concurrency())
+        : shards_(new shard[detail::shard_count(shards)]), mask_(detail::shard_count(shards) - 1)
+    {
+    }
+
+    sharded_counter(const sharded_counter&) = delete;
+    sharded_counter& operator=(const sharded_counter&) = delete;
+
+    [[nodiscard]] std::size_t shards() const noexcept { return mask_ + 1; }
+
+    void add(const Q& q) noexcept { local().fetch_add(q, std::memory_order_relaxed); }
+    void sub(const Q& q) noexcept { local().fetch_sub(q, std::memory_order_relaxed); }
+
+    sharded_counter& operator+=(const Q& q) noexcept
+    {
+      add(q);
+      return *this;
+    }
+
+    sharded_counter& operator-=(const Q& q) noexcept
+    {
+      sub(q);
+      return *this;
+    }
+
+    template<Quantity To = Q>
+    [[nodiscard]] To load() const noexcept
+      requires std::Same<typename To::dimension, typename Q::dimension>
+    {
+      Q sum(quantity_values<rep>::zero());
+      for (std::size_t i = 0; i <= mask_; ++i) sum += shards_[i].value.load(std::memory_order_relaxed);
+      return quantity_cast<To>(sum);
+    }
+
+    void reset() noexcept
+    {
+      for (std::size_t i = 0; i <= mask_; ++i)
+        shards_[i].value.store(Q(quantity_values<rep>::zero()), std::memory_order_relaxed);
+    }
+  };
+
+}  // namespace units
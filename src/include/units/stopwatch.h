@@ -0,0 +1,156 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/time.h>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#include <x86intrin.h>
+#define UNITS_DETAIL_HAS_TSC
+#endif
+
+namespace units {
+
+  namespace detail {
+
+    // Ticks are converted to nanoseconds with a 32.32 fixed-point multiplier so that no division
+    // is needed on the hot path.
+    struct tick_calibration {
+      bool use_tsc;
+      std::uint64_t ns_per_tick;  // 32.32 fixed point
+    };
+
+    inline constexpr unsigned tick_fraction_bits = 32;
+
+    [[nodiscard]] inline std::uint64_t steady_ticks() noexcept
+    {
+      return static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+              .count());
+    }
+
+#ifdef UNITS_DETAIL_HAS_TSC
+
+    [[nodiscard]] inline bool has_invariant_tsc() noexcept
+    {
+      unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+      if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) return false;
+      return edx & (1u << 8);
+    }
+
+#endif  // UNITS_DETAIL_HAS_TSC
+
+    [[nodiscard]] inline tick_calibration calibrate_ticks()
+    {
+#ifdef UNITS_DETAIL_HAS_TSC
+      if (has_invariant_tsc()) {
+        const std::uint64_t tsc_start = __rdtsc();
+        const std::uint64_t ns_start = steady_ticks();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        const std::uint64_t tsc_end = __rdtsc();
+        const std::uint64_t ns_end = steady_ticks();
+        if (tsc_end > tsc_start) {
+          const auto ns = static_cast<unsigned __int128>(ns_end - ns_start) << tick_fraction_bits;
+          return {true, static_cast<std::uint64_t>(ns / (tsc_end - tsc_start))};
+        }
+      }
+#endif  // UNITS_DETAIL_HAS_TSC
+      return {false, std::uint64_t(1) << tick_fraction_bits};
+    }
+
+    // Calibrated on the first use (blocking the calling thread for about 10 ms) so that programs not
+    // reading the clock do not pay for it and the clock works from any static initializer too.
+    [[nodiscard]] inline const tick_calibration& tick_calibration_data()
+    {
+      static const tick_calibration calibration = calibrate_ticks();
+      return calibration;
+    }
+
+  }  // namespace detail
+
+  // tsc_clock
+  //
+  // Low overhead monotonic clock. Reads the invariant TSC when the CPU provides one and falls back
+  // to std::chrono::steady_clock otherwise. The TSC frequency is calibrated on the first use of the
+  // clock; call calibrate() up front (i.e. at startup) to keep that delay off a latency-critical path.
+
+  struct tsc_clock {
+    using duration = time<nanosecond, std::int64_t>;
+
+    static void calibrate() { (void)detail::tick_calibration_data(); }
+
+    [[nodiscard]] static bool is_tsc() noexcept { return detail::tick_calibration_data().use_tsc; }
+
+    [[nodiscard]] static std::uint64_t ticks() noexcept
+    {
+#ifdef UNITS_DETAIL_HAS_TSC
+      if (detail::tick_calibration_data().use_tsc) return __rdtsc();
+#endif
+      return detail::steady_ticks();
+    }
+
+    [[nodiscard]] static duration to_duration(std::uint64_t ticks) noexcept
+    {
+#ifdef UNITS_DETAIL_HAS_TSC
+      if (detail::tick_calibration_data().use_tsc) {
+        const auto ns = (static_cast<unsigned __int128>(ticks) * detail::tick_calibration_data().ns_per_tick) >>
+                        detail::tick_fraction_bits;
+        return duration(static_cast<std::int64_t>(ns));
+      }
+#endif
+      return duration(static_cast<std::int64_t>(ticks));
+    }
+
+    [[nodiscard]] static duration now() noexcept { return to_duration(ticks()); }
+  };
+
+  // stopwatch
+
+  class stopwatch {
+    std::uint64_t start_ = tsc_clock::ticks();
+
+  public:
+    void restart() noexcept { start_ = tsc_clock::ticks(); }
+
+    [[nodiscard]] tsc_clock::duration elapsed() const noexcept
+    {
+      return tsc_clock::to_duration(tsc_clock::ticks() - start_);
+    }
+
+    tsc_clock::duration lap() noexcept
+    {
+      const std::uint64_t now = tsc_clock::ticks();
+      const auto result = tsc_clock::to_duration(now - start_);
+      start_ = now;
+      return result;
+    }
+  };
+
+}  // namespace units
+
+#undef UNITS_DETAIL_HAS_TSC
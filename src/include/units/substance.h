@@ -38,6 +38,8 @@ namespace units {
 
   struct mole : unit<dimension_substance> {};
   template<> struct upcasting_traits<upcast_from<mole>> : upcast_to<mole> {};
+  template<> inline constexpr std::string_view unit_symbol<mole> = "mol";
+  UNITS_EXTERN_QUANTITY(mole);
 
   inline namespace literals {
 
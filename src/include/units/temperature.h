@@ -38,6 +38,8 @@ namespace units {
 
   struct kelvin : unit<dimension_temperature> {};
   template<> struct upcasting_traits<upcast_from<kelvin>> : upcast_to<kelvin> {};
+  template<> inline constexpr std::string_view unit_symbol<kelvin> = "K";
+  UNITS_EXTERN_QUANTITY(kelvin);
 
   inline namespace literals {
 
@@ -0,0 +1,157 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace units {
+
+  // thread_pool
+  //
+  // Fixed set of worker threads reused by the parallel kernels so that a call does not pay for
+  // creating and joining threads. size() counts the calling thread which always runs one band itself.
+  // parallel_for calls from different threads are serialized; calling it from inside a band deadlocks.
+
+  class thread_pool {
+    std::vector<std::thread> workers_;
+    std::mutex submit_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    void (*task_)(const void*, std::size_t) = nullptr;
+    const void* context_ = nullptr;
+    std::uint64_t generation_ = 0;
+    std::size_t pending_ = 0;
+    std::exception_ptr error_;
+    bool stop_ = false;
+
+    void run(std::size_t band)
+    {
+      std::uint64_t seen = 0;
+      std::unique_lock lock(mutex_);
+      while (true) {
+        start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_) return;
+        seen = generation_;
+        const auto task = task_;
+        const void* context = context_;
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+          task(context, band);
+        }
+        catch (...) {
+          error = std::current_exception();
+        }
+        lock.lock();
+        if (error && !error_) error_ = error;
+        if (--pending_ == 0) done_.notify_one();
+      }
+    }
+
+  public:
+    explicit thread_pool(std::size_t threads = std::thread::hardware_concurrency())
+    {
+      threads = std::max<std::size_t>(threads, 1);
+      workers_.reserve(threads - 1);
+      for (std::size_t t = 0; t < threads - 1; ++t) workers_.emplace_back([this, t] { run(t); });
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool()
+    {
+      {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+      }
+      start_.notify_all();
+      for (auto& w : workers_) w.join();
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return workers_.size() + 1; }
+
+    // Splits [first, last) into at most size() contiguous bands and calls f(band_first, band_last)
+    // for each of them. Returns when all bands are done and rethrows the first exception of a band.
+    template<typename F>
+    void parallel_for(std::size_t first, std::size_t last, F f)
+    {
+      const std::size_t count = last > first ? last - first : 0;
+      const std::size_t bands = std::clamp<std::size_t>(size(), 1, std::max<std::size_t>(count, 1));
+      if (bands == 1) {
+        if (count > 0) f(first, last);
+        return;
+      }
+
+      struct context {
+        F& f;
+        std::size_t first, bands, band, rest;
+
+        void operator()(std::size_t b) const
+        {
+          const std::size_t begin = first + b * band + std::min(b, rest);
+          f(begin, begin + band + (b < rest ? 1 : 0));
+        }
+      };
+      const context ctx{f, first, bands, count / bands, count % bands};
+
+      std::lock_guard submit(submit_);
+      {
+        std::lock_guard lock(mutex_);
+        task_ = [](const void* c, std::size_t b) {
+          const auto& ctx = *static_cast<const context*>(c);
+          if (b + 1 < ctx.bands) ctx(b);
+        };
+        context_ = &ctx;
+        pending_ = workers_.size();
+        error_ = nullptr;
+        ++generation_;
+      }
+      start_.notify_all();
+
+      // the last band runs on the calling thread; workers past the band count return at once
+      std::exception_ptr error;
+      try {
+        ctx(bands - 1);
+      }
+      catch (...) {
+        error = std::current_exception();
+      }
+
+      std::unique_lock lock(mutex_);
+      done_.wait(lock, [&] { return pending_ == 0; });
+      if (!error) error = error_;
+      if (error) std::rethrow_exception(error);
+    }
+  };
+
+}  // namespace units
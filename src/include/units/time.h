@@ -38,21 +38,33 @@ namespace units {
 
   struct second : unit<dimension_time> {};
   template<> struct upcasting_traits<upcast_from<second>> : upcast_to<second> {};
+  template<> inline constexpr std::string_view unit_symbol<second> = "s";
+  UNITS_EXTERN_QUANTITY(second);
 
   struct nanosecond : nano<second> {};
   template<> struct upcasting_traits<upcast_from<nanosecond>> : upcast_to<nanosecond> {};
+  template<> inline constexpr std::string_view unit_symbol<nanosecond> = "ns";
+  UNITS_EXTERN_QUANTITY(nanosecond);
 
   struct microsecond : micro<second> {};
   template<> struct upcasting_traits<upcast_from<microsecond>> : upcast_to<microsecond> {};
+  template<> inline constexpr std::string_view unit_symbol<microsecond> = "µs";
+  UNITS_EXTERN_QUANTITY(microsecond);
 
   struct millisecond : milli<second> {};
   template<> struct upcasting_traits<upcast_from<millisecond>> : upcast_to<millisecond> {};
+  template<> inline constexpr std::string_view unit_symbol<millisecond> = "ms";
+  UNITS_EXTERN_QUANTITY(millisecond);
 
   struct minute : unit<dimension_time, ratio<60>> {};
   template<> struct upcasting_traits<upcast_from<minute>> : upcast_to<minute> {};
+  template<> inline constexpr std::string_view unit_symbol<minute> = "min";
+  UNITS_EXTERN_QUANTITY(minute);
 
   struct hour : unit<dimension_time, ratio<3600>> {};
   template<> struct upcasting_traits<upcast_from<hour>> : upcast_to<hour> {};
+  template<> inline constexpr std::string_view unit_symbol<hour> = "h";
+  UNITS_EXTERN_QUANTITY(hour);
 
   inline namespace literals {
 
@@ -0,0 +1,239 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/time.h>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace units {
+
+  // timer_wheel
+  //
+  // Hierarchical timer wheel driven by ticks of the Tick time quantity. Delays and periods may be
+  // provided in any time unit and are converted to ticks once when a timer is scheduled (rounding up
+  // so that a timer never fires early) which leaves no unit conversions in the tick loop.
+  //
+  // Timer nodes live in a pool owned by the wheel and are linked with indices into intrusive
+  // doubly-linked lists so scheduling and cancelling are O(1) and do not allocate after the pool
+  // grew to the number of concurrently live timers. The wheel is not thread-safe.
+
+  template<Time Tick, typename Callback = std::function<void()>>
+      requires std::Integral<typename Tick::rep>
+  class timer_wheel {
+  public:
+    struct timer_id {
+      std::uint32_t index;
+      std::uint32_t generation;
+    };
+
+  private:
+    static constexpr unsigned slot_bits = 8;
+    static constexpr std::uint32_t slots_per_level = 1u << slot_bits;
+    static constexpr std::uint32_t slot_mask = slots_per_level - 1;
+    static constexpr unsigned levels = 4;
+    static constexpr std::uint64_t max_delta = (std::uint64_t(1) << (slot_bits * levels)) - 1;
+    static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+    struct node {
+      std::uint64_t expiry = 0;
+      std::uint64_t period = 0;
+      Callback callback{};
+      std::uint32_t prev = npos;
+      std::uint32_t next = npos;
+      std::uint32_t slot = npos;
+      std::uint32_t generation = 0;
+    };
+
+    std::vector<node> nodes_;
+    std::array<std::uint32_t, slots_per_level * levels> heads_;
+    std::uint32_t free_head_ = npos;
+    std::uint32_t firing_ = npos;
+    std::uint64_t current_ = 0;
+    std::size_t size_ = 0;
+
+    template<Time T>
+    [[nodiscard]] static std::uint64_t to_ticks(const T& t)
+    {
+      auto ticks = quantity_cast<Tick>(t).count();
+      if (Tick(ticks) < t) ++ticks;
+      return ticks > 0 ? static_cast<std::uint64_t>(ticks) : 0;
+    }
+
+    [[nodiscard]] std::uint32_t allocate()
+    {
+      if (free_head_ == npos) {
+        nodes_.emplace_back();
+        return static_cast<std::uint32_t>(nodes_.size() - 1);
+      }
+      const std::uint32_t index = free_head_;
+      free_head_ = nodes_[index].next;
+      return index;
+    }
+
+    void release(std::uint32_t index)
+    {
+      node& n = nodes_[index];
+      n.callback = Callback{};
+      n.slot = npos;
+      n.prev = npos;
+      ++n.generation;
+      n.next = free_head_;
+      free_head_ = index;
+      --size_;
+    }
+
+    void link(std::uint32_t index)
+    {
+      node& n = nodes_[index];
+      const std::uint64_t delta = std::min(n.expiry - current_, max_delta);
+      unsigned level = 0;
+      while (delta >> (slot_bits * (level + 1))) ++level;
+      const std::uint64_t target = current_ + delta;
+      n.slot = level * slots_per_level + ((target >> (slot_bits * level)) & slot_mask);
+      n.prev = npos;
+      n.next = heads_[n.slot];
+      if (n.next != npos) nodes_[n.next].prev = index;
+      heads_[n.slot] = index;
+    }
+
+    void unlink(std::uint32_t index)
+    {
+      node& n = nodes_[index];
+      if (n.prev != npos)
+        nodes_[n.prev].next = n.next;
+      else
+        heads_[n.slot] = n.next;
+      if (n.next != npos) nodes_[n.next].prev = n.prev;
+      n.slot = npos;
+    }
+
+    void cascade(unsigned level)
+    {
+      const std::uint32_t slot = level * slots_per_level + ((current_ >> (slot_bits * level)) & slot_mask);
+      std::uint32_t index = std::exchange(heads_[slot], npos);
+      while (index != npos) {
+        const std::uint32_t next = nodes_[index].next;
+        link(index);
+        index = next;
+      }
+    }
+
+    template<typename F>
+    [[nodiscard]] timer_id add(std::uint64_t delay, std::uint64_t period, F&& callback)
+    {
+      const std::uint32_t index = allocate();
+      node& n = nodes_[index];
+      n.expiry = current_ + std::max<std::uint64_t>(delay, 1);
+      n.period = period;
+      n.callback = std::forward<F>(callback);
+      ++size_;
+      link(index);
+      return {index, n.generation};
+    }
+
+  public:
+    explicit timer_wheel(std::size_t capacity = 0)
+    {
+      heads_.fill(npos);
+      nodes_.reserve(capacity);
+    }
+
+    [[nodiscard]] Tick now() const noexcept { return Tick(static_cast<typename Tick::rep>(current_)); }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    template<Time T, typename F>
+    timer_id schedule(const T& delay, F&& callback)
+    {
+      return add(to_ticks(delay), 0, std::forward<F>(callback));
+    }
+
+    template<Time T1, Time T2, typename F>
+    timer_id schedule_periodic(const T1& delay, const T2& period, F&& callback)
+    {
+      return add(to_ticks(delay), std::max<std::uint64_t>(to_ticks(period), 1), std::forward<F>(callback));
+    }
+
+    bool cancel(timer_id id) noexcept
+    {
+      if (id.index >= nodes_.size()) return false;
+      node& n = nodes_[id.index];
+      if (n.generation != id.generation) return false;
+      if (id.index == firing_) {
+        // cancelled from its own callback; released after the callback returns
+        n.period = 0;
+        return true;
+      }
+      if (n.slot == npos) return false;
+      unlink(id.index);
+      release(id.index);
+      return true;
+    }
+
+    // Advances the wheel by one tick and runs the callbacks of the expired timers.
+    // Returns the number of fired timers.
+    std::size_t tick()
+    {
+      ++current_;
+      for (unsigned level = levels - 1; level > 0; --level)
+        if ((current_ & ((std::uint64_t(1) << (slot_bits * level)) - 1)) == 0) cascade(level);
+
+      std::size_t fired = 0;
+      const std::uint32_t slot = current_ & slot_mask;
+      while (heads_[slot] != npos) {
+        const std::uint32_t index = heads_[slot];
+        unlink(index);
+        // the callback may schedule timers which can reallocate the pool, so it runs from a local
+        Callback callback = std::move(nodes_[index].callback);
+        firing_ = index;
+        callback();
+        firing_ = npos;
+        ++fired;
+        node& n = nodes_[index];
+        if (n.period != 0) {
+          n.callback = std::move(callback);
+          n.expiry = current_ + n.period;
+          link(index);
+        }
+        else
+          release(index);
+      }
+      return fired;
+    }
+
+    template<Time T>
+    std::size_t advance(const T& elapsed)
+    {
+      std::size_t fired = 0;
+      for (std::uint64_t ticks = to_ticks(elapsed); ticks > 0; --ticks) fired += tick();
+      return fired;
+    }
+  };
+
+}  // namespace units
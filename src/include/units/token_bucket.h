@@ -0,0 +1,225 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/frequency.h>
+#include <units/stopwatch.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace units {
+
+  // token_bucket
+  //
+  // Lock-free rate limiter configured with a refill rate (frequency) and a burst window (time).
+  // The bucket holds up to rate * burst tokens. It is implemented as the Generic Cell Rate Algorithm
+  // equivalent of a token bucket: the whole state is one "theoretical arrival time" so acquiring
+  // tokens is a single CAS on that word. All unit conversions and the floating-point division happen
+  // once in the constructor.
+  //
+  // Times are kept in fixed point with up to 10 fractional bits of a nanosecond, so rates above
+  // 1e8 Hz are not rounded to a whole number of nanoseconds per token. They are relative to an origin
+  // that starts at the time of the first call and is moved forward whenever the relative time gets
+  // past half of the fixed point range (about 6.5 days at 1e9 Hz), so any uptime is covered. The
+  // burst window is limited to a quarter of that (about 1.6 days at 1e9 Hz). The state word carries
+  // the parity of the origin it is relative to; the origin is moved by one thread at a time while
+  // the others go on acquiring tokens.
+
+  class token_bucket {
+    using ns = time<nanosecond, std::int64_t>;
+
+    static constexpr std::int64_t no_origin = std::numeric_limits<std::int64_t>::min();
+
+    // now and the theoretical arrival time in the fixed point units, and the state word they were read from
+    struct view {
+      std::int64_t state;
+      std::int64_t tat;
+      std::int64_t now;
+    };
+
+    unsigned shift_;             // fractional bits of a nanosecond
+    std::int64_t interval_;      // time needed to refill one token
+    std::int64_t tolerance_;     // how far the theoretical arrival time may run ahead of now
+    std::int64_t limit_ns_;      // range of the relative times
+    std::atomic<std::int64_t> origins_ns_[2] = {no_origin, no_origin};
+    std::atomic<std::int64_t> state_{0};  // theoretical arrival time * 2 + parity of its origin
+    std::atomic_flag rebasing_ = ATOMIC_FLAG_INIT;
+
+    template<Frequency F>
+    [[nodiscard]] static double interval_ns(const F& rate)
+    {
+      const frequency<hertz, double> hz = rate;
+      Expects(hz.count() > 0);
+      const time<nanosecond, double> interval = 1.0 / hz;
+      return interval.count();
+    }
+
+    // fraction bits giving the interval at least 10 significant bits
+    [[nodiscard]] static unsigned fraction_bits(double interval_ns) noexcept
+    {
+      unsigned bits = 0;
+      while (bits < 10 && interval_ns * static_cast<double>(std::int64_t(1) << bits) < 1024) ++bits;
+      return bits;
+    }
+
+    [[nodiscard]] static std::int64_t state(std::int64_t tat, std::int64_t parity) noexcept { return tat * 2 + parity; }
+
+    // now_ns - origin_ns saturated to the range of the relative times
+    [[nodiscard]] std::int64_t relative_ns(std::int64_t now_ns, std::int64_t origin_ns) const noexcept
+    {
+      std::int64_t rel;
+      if (__builtin_sub_overflow(now_ns, origin_ns, &rel)) rel = now_ns > origin_ns ? limit_ns_ : -limit_ns_;
+      return std::clamp(rel, -limit_ns_, limit_ns_);
+    }
+
+    [[nodiscard]] view load(std::int64_t now_ns, std::int64_t s) const noexcept
+    {
+      std::int64_t origin = origins_ns_[s & 1].load(std::memory_order_relaxed);
+      if (origin == no_origin) origin = now_ns;
+      return {s, s >> 1, relative_ns(now_ns, origin) * (std::int64_t(1) << shift_)};
+    }
+
+    [[nodiscard]] view load(const ns& now) const noexcept
+    {
+      return load(now.count(), state_.load(std::memory_order_acquire));
+    }
+
+    // as above but sets the origin on the first call and moves it forward when needed
+    [[nodiscard]] view load(const ns& now) noexcept
+    {
+      const std::int64_t now_ns = now.count();
+      for (;;) {
+        const std::int64_t s = state_.load(std::memory_order_acquire);
+        std::int64_t origin = origins_ns_[s & 1].load(std::memory_order_relaxed);
+        if (origin == no_origin && origins_ns_[0].compare_exchange_strong(origin, now_ns, std::memory_order_relaxed))
+          origin = now_ns;
+        const std::int64_t rel = relative_ns(now_ns, origin);
+        // while some other thread is moving the origin go on with the current one if still in the range
+        if (rel <= limit_ns_ / 2 || (!rebase(now_ns) && rel <= limit_ns_ / 4 * 3))
+          return {s, s >> 1, rel * (std::int64_t(1) << shift_)};
+      }
+    }
+
+    // makes now_ns the origin of the state; returns false if some other thread is doing it
+    bool rebase(std::int64_t now_ns) noexcept
+    {
+      if (rebasing_.test_and_set(std::memory_order_acquire)) return false;
+      std::int64_t s = state_.load(std::memory_order_acquire);
+      const std::int64_t parity = s & 1;
+      const std::int64_t rel = relative_ns(now_ns, origins_ns_[parity].load(std::memory_order_relaxed));
+      if (rel > limit_ns_ / 2) {
+        origins_ns_[parity ^ 1].store(now_ns, std::memory_order_relaxed);
+        std::int64_t tat;
+        do {
+          // an arrival time in the past means a full bucket
+          tat = (s >> 1) >> shift_ < rel ? 0 : (s >> 1) - rel * (std::int64_t(1) << shift_);
+        } while (!state_.compare_exchange_weak(s, state(tat, parity ^ 1), std::memory_order_release,
+                                               std::memory_order_acquire));
+      }
+      rebasing_.clear(std::memory_order_release);
+      return true;
+    }
+
+  public:
+    template<Frequency F, Time T>
+    token_bucket(const F& rate, const T& burst) : shift_(0), interval_(0), tolerance_(0), limit_ns_(0)
+    {
+      const double interval = interval_ns(rate);
+      shift_ = fraction_bits(interval);
+      // relative times, the tolerance and a cost (up to the tolerance) fit the state word together and
+      // every arrival time stays below the saturated time
+      limit_ns_ = std::numeric_limits<std::int64_t>::max() >> (shift_ + 3);
+      const double scale = static_cast<double>(std::int64_t(1) << shift_);
+      const std::int64_t burst_ns = quantity_cast<ns>(burst).count();
+      Expects(burst_ns < limit_ns_ / 8);
+      interval_ = std::max<std::int64_t>(1, std::llround(interval * scale));
+      tolerance_ = burst_ns * (std::int64_t(1) << shift_);
+      Expects(tolerance_ >= interval_);
+    }
+
+    token_bucket(const token_bucket&) = delete;
+    token_bucket& operator=(const token_bucket&) = delete;
+
+    [[nodiscard]] time<nanosecond, double> refill_interval() const noexcept
+    {
+      return time<nanosecond, double>(static_cast<double>(interval_) / static_cast<double>(std::int64_t(1) << shift_));
+    }
+    [[nodiscard]] std::int64_t capacity() const noexcept { return tolerance_ / interval_; }
+
+    // Fails without acquiring anything for more tokens than the capacity (or a negative number).
+    template<Time T>
+    [[nodiscard]] bool try_acquire_at(const T& now, std::int64_t tokens = 1) noexcept
+    {
+      if (tokens < 0 || tokens > capacity()) return false;
+      const std::int64_t cost = tokens * interval_;
+      for (;;) {
+        // reloaded after a failed CAS as the origin might have moved
+        view v = load(quantity_cast<ns>(now));
+        const std::int64_t new_tat = std::max(v.tat, v.now) + cost;
+        if (new_tat - v.now > tolerance_) return false;
+        if (state_.compare_exchange_weak(v.state, state(new_tat, v.state & 1), std::memory_order_relaxed)) return true;
+      }
+    }
+
+    [[nodiscard]] bool try_acquire(std::int64_t tokens = 1) noexcept
+    {
+      return try_acquire_at(tsc_clock::now(), tokens);
+    }
+
+    // acquires as many tokens as available (but not more than max_tokens) and returns their number
+    template<Time T>
+    [[nodiscard]] std::int64_t try_acquire_up_to_at(const T& now, std::int64_t max_tokens) noexcept
+    {
+      for (;;) {
+        view v = load(quantity_cast<ns>(now));
+        const std::int64_t base = std::max(v.tat, v.now);
+        const std::int64_t tokens = std::min(max_tokens, (v.now + tolerance_ - base) / interval_);
+        if (tokens <= 0) return 0;
+        if (state_.compare_exchange_weak(v.state, state(base + tokens * interval_, v.state & 1),
+                                         std::memory_order_relaxed))
+          return tokens;
+      }
+    }
+
+    [[nodiscard]] std::int64_t try_acquire_up_to(std::int64_t max_tokens) noexcept
+    {
+      return try_acquire_up_to_at(tsc_clock::now(), max_tokens);
+    }
+
+    template<Time T>
+    [[nodiscard]] std::int64_t available_at(const T& now) const noexcept
+    {
+      // a time past the range is past any arrival time too so the saturated one gives the same result
+      const view v = load(quantity_cast<ns>(now));
+      const std::int64_t base = std::max(v.tat, v.now);
+      return std::max<std::int64_t>(0, (v.now + tolerance_ - base) / interval_);
+    }
+
+    [[nodiscard]] std::int64_t available() const noexcept { return available_at(tsc_clock::now()); }
+  };
+
+}  // namespace units
@@ -25,6 +25,7 @@
 #include <units/dimension.h>
 #include <units/ratio.h>
 #include <ratio>
+#include <string_view>
 
 namespace units {
 
@@ -53,6 +54,14 @@ namespace units {
       detail::is_unit<upcast_from<T>>;
 
 
+  // unit_symbol
+  //
+  // Text symbol of a named unit (i.e. "km"). Specialized next to the definition of every named unit;
+  // empty for the units that do not have a name.
+
+  template<Unit U>
+  inline constexpr std::string_view unit_symbol{};
+
   // derived_unit
 
   namespace detail {
@@ -0,0 +1,253 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/area.h>
+#include <units/current.h>
+#include <units/dynamic_quantity.h>
+#include <units/frequency.h>
+#include <units/length.h>
+#include <units/luminous_intensity.h>
+#include <units/mass.h>
+#include <units/substance.h>
+#include <units/temperature.h>
+#include <units/time.h>
+#include <units/velocity.h>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+namespace units {
+
+  // unit_symbol_alias
+  //
+  // Additional plain ASCII spelling of a unit symbol accepted by the symbol lookups.
+
+  template<Unit U>
+  inline constexpr std::string_view unit_symbol_alias{};
+
+  template<> inline constexpr std::string_view unit_symbol_alias<microsecond> = "us";
+  template<> inline constexpr std::string_view unit_symbol_alias<square_millimeter> = "mm^2";
+  template<> inline constexpr std::string_view unit_symbol_alias<square_centimeter> = "cm^2";
+  template<> inline constexpr std::string_view unit_symbol_alias<square_meter> = "m^2";
+  template<> inline constexpr std::string_view unit_symbol_alias<square_kilometer> = "km^2";
+  template<> inline constexpr std::string_view unit_symbol_alias<square_foot> = "ft^2";
+  template<> inline constexpr std::string_view unit_symbol_alias<kilometer_per_hour> = "kmph";
+  template<> inline constexpr std::string_view unit_symbol_alias<mile_per_hour> = "mph";
+
+  // unit_list
+
+  template<Unit... Us>
+  struct unit_list {};
+
+  // All the named units of the library
+  using registered_units =
+      unit_list<meter, millimeter, centimeter, kilometer, yard, foot, inch, mile,
+                gram, kilogram,
+                second, nanosecond, microsecond, millisecond, minute, hour,
+                ampere, kelvin, mole, candela,
+                square_millimeter, square_centimeter, square_meter, square_kilometer, square_foot,
+                hertz, millihertz, kilohertz, megahertz, gigahertz, terahertz,
+                meter_per_second, kilometer_per_hour, mile_per_hour>;
+
+  namespace detail {
+
+    [[nodiscard]] constexpr std::uint32_t symbol_hash(std::string_view s, std::uint32_t seed) noexcept
+    {
+      std::uint32_t h = 2166136261u ^ seed;
+      for (char c : s) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 16777619u;
+      }
+      return h ^ (h >> 15);
+    }
+
+    // Collision-free hash of a fixed set of N distinct strings found at compile time
+    template<std::size_t N>
+    struct perfect_hash {
+      static constexpr std::size_t capacity = [] {
+        std::size_t c = 1;
+        while (c < 4 * N) c <<= 1;
+        return c;
+      }();
+
+      std::uint32_t seed = 0;
+      std::array<std::uint16_t, capacity> slots{};  // index + 1 of the key (0 for an empty slot)
+
+      // index of the key in `keys` or N if not found
+      [[nodiscard]] constexpr std::size_t find(std::string_view key, const std::array<std::string_view, N>& keys) const
+      {
+        if constexpr (N == 0) {
+          return 0;
+        }
+        else {
+          const std::size_t idx = slots[symbol_hash(key, seed) & (capacity - 1)];
+          return idx != 0 && keys[idx - 1] == key ? idx - 1 : N;
+        }
+      }
+    };
+
+    template<std::size_t N>
+    [[nodiscard]] constexpr perfect_hash<N> make_perfect_hash(const std::array<std::string_view, N>& keys)
+    {
+      static_assert(N < 0xFFFF);
+      perfect_hash<N> result;
+      for (std::uint32_t seed = 0;; ++seed) {
+        result.seed = seed;
+        result.slots = {};
+        bool ok = true;
+        for (std::size_t i = 0; i < N && ok; ++i) {
+          auto& slot = result.slots[symbol_hash(keys[i], seed) & (result.capacity - 1)];
+          ok = slot == 0;
+          slot = static_cast<std::uint16_t>(i + 1);
+        }
+        if (ok) return result;
+      }
+    }
+
+  }  // namespace detail
+
+  // unit_ratio
+
+  struct unit_ratio {
+    std::intmax_t num;
+    std::intmax_t den;
+  };
+
+  using unit_id = std::uint16_t;
+
+  // unit_registry
+  //
+  // Compile-time enumeration of units giving every unit a dense id. Properties of the units
+  // are available in tables indexed with the id, and visit() dispatches a runtime id to a call
+  // with a static quantity type through a jump table.
+
+  template<typename Units = registered_units>
+  class basic_unit_registry;
+
+  template<Unit... Us>
+  class basic_unit_registry<unit_list<Us...>> {
+    template<Unit U>
+    static constexpr std::size_t index_of()
+    {
+      std::size_t i = 0, result = sizeof...(Us);
+      ((std::is_same_v<U, Us> ? (void)(result = i++) : (void)i++), ...);
+      return result;
+    }
+
+    static constexpr std::size_t alias_count = (std::size_t(!unit_symbol_alias<Us>.empty()) + ... + 0);
+
+    // symbols followed by the aliases and the ids of their units
+    static constexpr auto keys = [] {
+      std::array<std::string_view, sizeof...(Us) + alias_count> result{unit_symbol<Us>...};
+      std::size_t i = sizeof...(Us);
+      ((unit_symbol_alias<Us>.empty() ? void() : (void)(result[i++] = unit_symbol_alias<Us>)), ...);
+      return result;
+    }();
+
+    static constexpr auto key_ids = [] {
+      std::array<unit_id, keys.size()> result{};
+      std::size_t i = 0;
+      for (; i < sizeof...(Us); ++i) result[i] = static_cast<unit_id>(i);
+      unit_id id = 0;
+      ((unit_symbol_alias<Us>.empty() ? (void)++id : (void)(result[i++] = id++)), ...);
+      return result;
+    }();
+
+    static constexpr detail::perfect_hash<keys.size()> hash = detail::make_perfect_hash(keys);
+
+  public:
+    using units = unit_list<Us...>;
+
+    static constexpr std::size_t size = sizeof...(Us);
+
+    template<Unit U>
+    static constexpr bool contains = index_of<U>() < size;
+
+    template<Unit U>
+        requires contains<U>
+    static constexpr unit_id id = static_cast<unit_id>(index_of<U>());
+
+    static constexpr std::array<std::string_view, size> symbols{unit_symbol<Us>...};
+    static constexpr std::array<packed_dimension, size> dimensions{packed_dimension::of<typename Us::dimension>()...};
+    static constexpr std::array<unit_ratio, size> ratios{unit_ratio{Us::ratio::num, Us::ratio::den}...};
+
+    // ratio to the coherent unit of the dimension
+    static constexpr std::array<double, size> magnitudes{static_cast<double>(Us::ratio::num) /
+                                                         static_cast<double>(Us::ratio::den)...};
+
+    // id of the unit with the symbol (or its alias)
+    [[nodiscard]] static constexpr std::optional<unit_id> find(std::string_view symbol) noexcept
+    {
+      const std::size_t i = hash.find(symbol, keys);
+      if (i == keys.size()) return std::nullopt;
+      return key_ids[i];
+    }
+
+    // factor converting values of the `from` unit to the `to` unit; throws dimension_mismatch
+    [[nodiscard]] static constexpr double conversion_factor(unit_id from, unit_id to)
+    {
+      Expects(from < size && to < size);
+      if (dimensions[from] != dimensions[to])
+        throw dimension_mismatch("units::unit_registry: conversion between different dimensions");
+      const unit_ratio& f = ratios[from];
+      const unit_ratio& t = ratios[to];
+      return (static_cast<double>(f.num) * static_cast<double>(t.den)) /
+             (static_cast<double>(f.den) * static_cast<double>(t.num));
+    }
+
+    [[nodiscard]] static constexpr dynamic_quantity make_dynamic(unit_id id, double value)
+    {
+      Expects(id < size);
+      return dynamic_quantity(value, dimensions[id], magnitudes[id]);
+    }
+
+    // visit
+    //
+    // Calls f(quantity<U::dimension, U, Rep>(value)) where U is the unit with the given id.
+    // All the calls have to return the same type.
+
+    template<typename Rep = double, typename F>
+    static decltype(auto) visit(unit_id id, Rep value, F&& f)
+    {
+      Expects(id < size);
+      using first = std::tuple_element_t<0, std::tuple<Us...>>;
+      using result = std::invoke_result_t<F&, quantity<typename first::dimension, first, Rep>>;
+      using fn = result (*)(F&, Rep);
+      static constexpr fn table[] = {[](F& f, Rep value) -> result {
+        return std::invoke(f, quantity<typename Us::dimension, Us, Rep>(value));
+      }...};
+      return table[id](f, value);
+    }
+  };
+
+  using unit_registry = basic_unit_registry<>;
+
+  template<Unit U>
+  inline constexpr unit_id unit_id_of = unit_registry::id<U>;
+
+}  // namespace units
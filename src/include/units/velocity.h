@@ -38,12 +38,18 @@ namespace units {
 
   struct meter_per_second : derived_unit<dimension_velocity, meter, second> {};
   template<> struct upcasting_traits<upcast_from<meter_per_second>> : upcast_to<meter_per_second> {};
+  template<> inline constexpr std::string_view unit_symbol<meter_per_second> = "m/s";
+  UNITS_EXTERN_QUANTITY(meter_per_second);
 
   struct kilometer_per_hour : derived_unit<dimension_velocity, kilometer, hour> {};
   template<> struct upcasting_traits<upcast_from<kilometer_per_hour>> : upcast_to<kilometer_per_hour> {};
+  template<> inline constexpr std::string_view unit_symbol<kilometer_per_hour> = "km/h";
+  UNITS_EXTERN_QUANTITY(kilometer_per_hour);
 
   struct mile_per_hour : derived_unit<dimension_velocity, mile, hour> {};
   template<> struct upcasting_traits<upcast_from<mile_per_hour>> : upcast_to<mile_per_hour> {};
+  template<> inline constexpr std::string_view unit_symbol<mile_per_hour> = "mi/h";
+  UNITS_EXTERN_QUANTITY(mile_per_hour);
 
   inline namespace literals {
 
@@ -0,0 +1,102 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/quantity.h>
+#include <experimental/ranges/ranges>
+#include <utility>
+
+namespace units {
+
+  namespace detail {
+
+    namespace ranges = std::experimental::ranges;
+
+    template<Quantity Q>
+    struct to_quantity_fn {
+      template<typename Rep>
+      constexpr Q operator()(const Rep& r) const requires std::is_constructible_v<Q, const Rep&>
+      {
+        return Q(r);
+      }
+    };
+
+    template<Quantity To>
+    struct quantity_cast_fn {
+      template<Quantity Q>
+      constexpr To operator()(const Q& q) const requires std::Same<typename To::dimension, typename Q::dimension>
+      {
+        return quantity_converter<To, Q>{}(q);
+      }
+    };
+
+    struct count_fn {
+      template<Quantity Q>
+      constexpr typename Q::rep operator()(const Q& q) const
+      {
+        return q.count();
+      }
+    };
+
+    // Range adaptor applying F lazily to every element of the range
+    template<typename F>
+    struct transform_adaptor {
+      template<typename R>
+      constexpr auto operator()(R&& r) const -> decltype(ranges::view::transform(std::forward<R>(r), F{}))
+      {
+        return ranges::view::transform(std::forward<R>(r), F{});
+      }
+
+      template<typename R>
+      friend constexpr auto operator|(R&& r, transform_adaptor a) -> decltype(a(std::forward<R>(r)))
+      {
+        return a(std::forward<R>(r));
+      }
+    };
+
+  }  // namespace detail
+
+  // Lazy range adaptors
+  //
+  // Each of them is a view over the underlying range so they can be composed with other views
+  // without materializing intermediate containers:
+  //   raw | views::as_quantity<length<kilometer, double>> | views::quantity_cast<length<meter, double>>
+
+  namespace views {
+
+    // raw reps -> quantities
+    template<Quantity Q>
+    inline constexpr detail::transform_adaptor<detail::to_quantity_fn<Q>> as_quantity{};
+
+    // quantities -> quantities of the same dimension in another unit (conversion factor is a compile-time constant);
+    // quantity_span_cast() is the counterpart for a quantity_span
+    template<Quantity To>
+    inline constexpr detail::transform_adaptor<detail::quantity_cast_fn<To>> quantity_cast{};
+
+    // quantities -> raw reps
+    inline constexpr detail::transform_adaptor<detail::count_fn> count{};
+
+  }  // namespace views
+
+}  // namespace units
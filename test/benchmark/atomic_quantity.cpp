@@ -0,0 +1,87 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Measures the cost of atomic_quantity updates under contention compared to the raw std::atomic
+// of the same rep. All threads hammer the same counter. sharded_counter is measured for comparison.
+
+#include <units/atomic_quantity.h>
+#include <units/length.h>
+#include <units/sharded_counter.h>
+#include <units/time.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  using namespace units;
+
+  constexpr std::size_t iterations = 1'000'000;
+
+  template<typename F>
+  double measure(unsigned threads, F f)
+  {
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < threads; ++t)
+      workers.emplace_back([&] {
+        for (std::size_t i = 0; i < iterations; ++i) f();
+      });
+    for (auto& w : workers) w.join();
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / (static_cast<double>(iterations) * threads);
+  }
+
+}  // namespace
+
+int main()
+{
+  const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+  for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+    std::atomic<std::int64_t> raw_int{0};
+    atomic_quantity<units::time<nanosecond, std::int64_t>> q_int;
+    const double raw_int_ns = measure(threads, [&] { raw_int.fetch_add(1000, std::memory_order_relaxed); });
+    const double q_int_ns = measure(threads, [&] { q_int.fetch_add(1_us, std::memory_order_relaxed); });
+
+    std::atomic<double> raw_fp{0};
+    atomic_quantity<length<meter, double>> q_fp;
+    const double raw_fp_ns = measure(threads, [&] {
+      double old = raw_fp.load(std::memory_order_relaxed);
+      while (!raw_fp.compare_exchange_weak(old, old + 1000.0, std::memory_order_relaxed)) {
+      }
+    });
+    const double q_fp_ns = measure(threads, [&] { q_fp.fetch_add(1_km, std::memory_order_relaxed); });
+
+    sharded_counter<units::time<nanosecond, std::int64_t>> sharded;
+    const double sharded_ns = measure(threads, [&] { sharded.add(1_us); });
+
+    std::cout << threads << " thread(s): int64 raw " << raw_int_ns << " ns/op, quantity " << q_int_ns
+              << " ns/op, sharded " << sharded_ns << " ns/op | double raw " << raw_fp_ns << " ns/op, quantity "
+              << q_fp_ns << " ns/op\n";
+  }
+}
@@ -0,0 +1,91 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Measures the latency of conversion_cache lookups under concurrent readers. Hits look up the
+// factors of all the convertible unit pairs of the registry, misses look up pairs that are never
+// inserted. The direct computation of the factor is measured for comparison.
+
+#include <units/conversion_cache.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+  using namespace units;
+
+  constexpr std::size_t rounds = 20'000;
+
+  template<typename F>
+  double measure(unsigned threads, std::size_t ops_per_round, F f)
+  {
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < threads; ++t)
+      workers.emplace_back([&] {
+        for (std::size_t i = 0; i < rounds; ++i) f();
+      });
+    for (auto& w : workers) w.join();
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / (static_cast<double>(rounds * ops_per_round) * threads);
+  }
+
+}  // namespace
+
+int main()
+{
+  std::vector<std::pair<unit_id, unit_id>> convertible, inconvertible;
+  for (unit_id from = 0; from < unit_registry::size; ++from)
+    for (unit_id to = 0; to < unit_registry::size; ++to)
+      (unit_registry::dimensions[from] == unit_registry::dimensions[to] ? convertible : inconvertible)
+          .emplace_back(from, to);
+
+  conversion_cache<> cache;
+  for (auto [from, to] : convertible) (void)cache.factor(from, to);
+
+  const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+    volatile double sink = 0;
+    const double hit_ns = measure(threads, convertible.size(), [&] {
+      double sum = 0;
+      for (auto [from, to] : convertible) sum += *cache.find(from, to);
+      sink = sum;
+    });
+    const double miss_ns = measure(threads, inconvertible.size(), [&] {
+      bool found = false;
+      for (auto [from, to] : inconvertible) found |= cache.find(from, to).has_value();
+      sink = found;
+    });
+    const double direct_ns = measure(threads, convertible.size(), [&] {
+      double sum = 0;
+      for (auto [from, to] : convertible) sum += unit_registry::conversion_factor(from, to);
+      sink = sum;
+    });
+    std::cout << threads << " thread(s): hit " << hit_ns << " ns/op, miss " << miss_ns << " ns/op, direct "
+              << direct_ns << " ns/op\n";
+  }
+}
@@ -0,0 +1,117 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Measures how much slower quantity arithmetic is compared to the same arithmetic done on raw reps.
+// Meant to be built without optimizations (-O0) where the overhead of the library layers is the most
+// visible. Build it once with and once without UNITS_FORCE_INLINE to see the gain of the debug
+// performance mode.
+
+#include <units/length.h>
+#include <units/velocity.h>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+  using namespace units;
+
+  constexpr std::size_t size = 1'000'000;
+  constexpr int repeats = 20;
+
+  template<typename F>
+  double measure(F f)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i) f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  void report(const char* name, double raw, double typed)
+  {
+    std::cout << name << ": raw " << raw << " ms, quantity " << typed << " ms, slowdown " << typed / raw << "x\n";
+  }
+
+}  // namespace
+
+int main()
+{
+  std::vector<double> km(size), m(size), h(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    km[i] = static_cast<double>(i % 100);
+    m[i] = static_cast<double>(i % 1000);
+    h[i] = 1.0 + static_cast<double>(i % 10);
+  }
+
+  std::vector<length<kilometer>> q_km(km.begin(), km.end());
+  std::vector<length<meter>> q_m(m.begin(), m.end());
+  std::vector<units::time<units::hour>> q_h(h.begin(), h.end());
+
+  volatile double sink = 0;
+
+  // mixed-unit addition
+  {
+    const double raw = measure([&] {
+      double sum = 0;
+      for (std::size_t i = 0; i < size; ++i) sum += km[i] * 1000 + m[i];
+      sink = sum;
+    });
+    const double typed = measure([&] {
+      length<meter> sum(0);
+      for (std::size_t i = 0; i < size; ++i) sum += q_km[i] + q_m[i];
+      sink = sum.count();
+    });
+    report("km + m", raw, typed);
+  }
+
+  // mixed-unit comparison
+  {
+    const double raw = measure([&] {
+      std::size_t cnt = 0;
+      for (std::size_t i = 0; i < size; ++i) cnt += km[i] * 1000 < m[i];
+      sink = static_cast<double>(cnt);
+    });
+    const double typed = measure([&] {
+      std::size_t cnt = 0;
+      for (std::size_t i = 0; i < size; ++i) cnt += q_km[i] < q_m[i];
+      sink = static_cast<double>(cnt);
+    });
+    report("km < m", raw, typed);
+  }
+
+  // dimension change
+  {
+    const double raw = measure([&] {
+      double sum = 0;
+      for (std::size_t i = 0; i < size; ++i) sum += km[i] / h[i];
+      sink = sum;
+    });
+    const double typed = measure([&] {
+      velocity<kilometer_per_hour> sum(0);
+      for (std::size_t i = 0; i < size; ++i) sum += q_km[i] / q_h[i];
+      sink = sum.count();
+    });
+    report("km / h", raw, typed);
+  }
+}
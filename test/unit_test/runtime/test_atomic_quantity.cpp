@@ -0,0 +1,153 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.h"
+#include <units/atomic_quantity.h>
+#include <units/length.h>
+#include <units/time.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  using namespace units;
+
+  constexpr int thread_count = 4;
+  constexpr int iterations = 20'000;
+
+  // runs f(results of the thread) on every thread and returns all the results sorted
+  template<typename T, typename F>
+  std::vector<T> run_concurrently(F f)
+  {
+    std::vector<std::vector<T>> results(thread_count);
+    std::vector<std::thread> threads;
+    for (auto& r : results) threads.emplace_back([&f, &r] { f(r); });
+    for (auto& t : threads) t.join();
+    std::vector<T> all;
+    for (const auto& r : results) all.insert(all.end(), r.begin(), r.end());
+    std::sort(all.begin(), all.end());
+    return all;
+  }
+
+  void fetch_add_returns_every_previous_value_once()
+  {
+    using ms = units::time<millisecond, std::int64_t>;
+    atomic_quantity<ms> total;
+    const auto previous = run_concurrently<ms>([&](std::vector<ms>& r) {
+      for (int i = 0; i < iterations; ++i) r.push_back(total.fetch_add(ms(1)));
+    });
+    CHECK(total.load() == ms(thread_count * iterations));
+    CHECK(previous.size() == thread_count * iterations);
+    for (std::size_t i = 0; i < previous.size(); ++i) CHECK(previous[i] == ms(static_cast<std::int64_t>(i)));
+  }
+
+  void fetch_sub_of_floating_point_returns_every_previous_value_once()
+  {
+    // floating-point reps go through a CAS loop; whole numbers keep the values exact
+    using m = length<meter, double>;
+    atomic_quantity<m> remaining(m(thread_count * iterations));
+    const auto previous = run_concurrently<m>([&](std::vector<m>& r) {
+      for (int i = 0; i < iterations; ++i) r.push_back(remaining.fetch_sub(m(1.0)));
+    });
+    CHECK(remaining.load() == m(0.0));
+    for (std::size_t i = 0; i < previous.size(); ++i) CHECK(previous[i] == m(static_cast<double>(i + 1)));
+  }
+
+  void converts_operands()
+  {
+    using mm = length<millimeter, std::int64_t>;
+    atomic_quantity<mm> distance;
+    const auto previous = run_concurrently<mm>([&](std::vector<mm>& r) {
+      for (int i = 0; i < iterations; ++i) {
+        r.push_back(distance.fetch_add(length<meter, std::int64_t>(2)));
+        r.push_back(distance.fetch_sub(length<meter, std::int64_t>(1)));
+      }
+    });
+    CHECK(distance.load() == mm(thread_count * iterations * 1'000));
+    CHECK(previous.size() == 2 * thread_count * iterations);
+    CHECK(previous.front() >= mm(0));
+    CHECK(previous.back() <= mm(thread_count * iterations * 2'000));
+  }
+
+  void compare_exchange_strong_updates_expected()
+  {
+    using s = units::time<second, std::int64_t>;
+    atomic_quantity<s> counter;
+    const auto claimed = run_concurrently<s>([&](std::vector<s>& r) {
+      s expected = counter.load();
+      for (int i = 0; i < iterations; ++i) {
+        // on failure expected holds the current value so the next attempt may succeed
+        while (!counter.compare_exchange_strong(expected, expected + s(1))) {
+        }
+        r.push_back(expected);
+        ++expected;
+      }
+    });
+    CHECK(counter.load() == s(thread_count * iterations));
+    for (std::size_t i = 0; i < claimed.size(); ++i) CHECK(claimed[i] == s(static_cast<std::int64_t>(i)));
+  }
+
+  void compare_exchange_weak_updates_expected()
+  {
+    using m = length<meter, double>;
+    atomic_quantity<m> maximum(m(-1.0));
+    run_concurrently<m>([&](std::vector<m>&) {
+      for (int i = 0; i < iterations; ++i) {
+        const m candidate(static_cast<double>(i));
+        m current = maximum.load(std::memory_order_relaxed);
+        while (current < candidate && !maximum.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+        }
+      }
+    });
+    CHECK(maximum.load() == m(iterations - 1.0));
+
+    m expected(0.0);
+    CHECK(!maximum.compare_exchange_strong(expected, m(5.0)));
+    CHECK(expected == m(iterations - 1.0));
+    CHECK(maximum.compare_exchange_strong(expected, m(5.0)));
+    CHECK(maximum.load() == m(5.0));
+  }
+
+  void exchanges_and_assigns()
+  {
+    using ms = units::time<millisecond, std::int64_t>;
+    atomic_quantity<ms> value(ms(10));
+    CHECK((value += ms(5)) == ms(15));
+    CHECK((value -= ms(20)) == ms(-5));
+    CHECK(value.exchange(ms(7)) == ms(-5));
+    CHECK((value = ms(9)) == ms(9));
+    CHECK(static_cast<ms>(value) == ms(9));
+    CHECK(value.is_lock_free());
+  }
+
+}  // namespace
+
+int main()
+{
+  fetch_add_returns_every_previous_value_once();
+  fetch_sub_of_floating_point_returns_every_previous_value_once();
+  converts_operands();
+  compare_exchange_strong_updates_expected();
+  compare_exchange_weak_updates_expected();
+  exchanges_and_assigns();
+}
@@ -0,0 +1,173 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.h"
+#include <units/compression.h>
+#include <units/length.h>
+#include <units/time.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+  using namespace units;
+
+  template<typename T>
+  std::uint64_t bits_of(T v)
+  {
+    std::uint64_t b = 0;
+    std::memcpy(&b, &v, sizeof(v));
+    return b;
+  }
+
+  template<Quantity Q>
+  compressed_quantities compress(const std::vector<Q>& values)
+  {
+    return units::compress(quantity_span<const Q>(values.data(), values.size()));
+  }
+
+  compressed_quantities through_stream(const compressed_quantities& c)
+  {
+    std::stringstream ss;
+    write_compressed(ss, c);
+    return read_compressed(ss);
+  }
+
+  std::vector<double> doubles()
+  {
+    using limits = std::numeric_limits<double>;
+    constexpr double inf = limits::infinity();
+    std::vector<double> v = {0.0, -0.0, 1.0, 1.0, 1.0, 1.5, -1e300, 1e-300, limits::denorm_min(), inf, inf, -inf,
+                             limits::quiet_NaN(), 2.0, 2.0, limits::max(), limits::lowest()};
+    std::mt19937_64 gen(42);
+    std::normal_distribution<double> step(0.0, 0.01);
+    double x = 20.0;
+    for (int i = 0; i < 10'000; ++i) {
+      if (i % 100 == 0) v.push_back(std::numeric_limits<double>::quiet_NaN());
+      if (i % 7 != 0) x += step(gen);  // runs of repeated values
+      v.push_back(x);
+    }
+    return v;
+  }
+
+  std::vector<std::int64_t> integers()
+  {
+    constexpr std::int64_t min = std::numeric_limits<std::int64_t>::min();
+    constexpr std::int64_t max = std::numeric_limits<std::int64_t>::max();
+    std::vector<std::int64_t> v = {0, 0, 0, min, max, min, max, -1, 1, 1'000'000'000'000, 0, max, max};
+    std::mt19937_64 gen(7);
+    std::int64_t t = 1'000'000;
+    for (int i = 0; i < 10'000; ++i) {
+      t += 1'000 + static_cast<std::int64_t>(gen() % 3) - 1;  // nearly regular timestamps
+      if (i % 500 == 0) t += static_cast<std::int64_t>(gen() % 1'000'000'000);  // large gaps
+      v.push_back(t);
+    }
+    return v;
+  }
+
+  void round_trips_doubles()
+  {
+    using m = length<meter, double>;
+    std::vector<m> values;
+    for (double d : doubles()) values.emplace_back(d);
+    const compressed_quantities c = through_stream(compress(values));
+    CHECK(c.size() == values.size());
+    CHECK(c.size_bytes() < values.size() * sizeof(double));
+
+    const std::vector<m> same = decompress<m>(c);
+    for (std::size_t i = 0; i < values.size(); ++i) CHECK(bits_of(same[i].count()) == bits_of(values[i].count()));
+
+    // the conversion factor is applied to every decoded value
+    const std::vector<length<kilometer, double>> km = decompress<length<kilometer, double>>(c);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      const double expected = values[i].count() * (1.0 / 1000.0);
+      if (std::isnan(expected))
+        CHECK(std::isnan(km[i].count()));
+      else
+        CHECK(bits_of(km[i].count()) == bits_of(expected));
+    }
+  }
+
+  void round_trips_floats()
+  {
+    using m = length<meter, float>;
+    std::vector<m> values;
+    for (double d : doubles()) values.emplace_back(static_cast<float>(d));
+    const std::vector<m> same = decompress<m>(through_stream(compress(values)));
+    for (std::size_t i = 0; i < values.size(); ++i) CHECK(bits_of(same[i].count()) == bits_of(values[i].count()));
+  }
+
+  void round_trips_integers()
+  {
+    using ms = units::time<millisecond, std::int64_t>;
+    std::vector<ms> values;
+    for (std::int64_t i : integers()) values.emplace_back(i);
+    const compressed_quantities c = through_stream(compress(values));
+    const std::vector<ms> same = decompress<ms>(c);
+    for (std::size_t i = 0; i < values.size(); ++i) CHECK(same[i] == values[i]);
+
+    const std::vector<units::time<second, double>> s = decompress<units::time<second, double>>(c);
+    for (std::size_t i = 0; i < values.size(); ++i)
+      CHECK(bits_of(s[i].count()) == bits_of(static_cast<double>(values[i].count()) * (1.0 / 1000.0)));
+
+    // timestamps only (the extremes would overflow microseconds)
+    const std::vector<ms> stamps(values.begin() + 13, values.end());
+    const auto us = decompress<units::time<microsecond, std::int64_t>>(compress(stamps));
+    for (std::size_t i = 0; i < stamps.size(); ++i) CHECK(us[i].count() == stamps[i].count() * 1'000);
+  }
+
+  void round_trips_unsigned()
+  {
+    using m = length<meter, std::uint32_t>;
+    const std::vector<m> values = {m(0), m(0), m(std::numeric_limits<std::uint32_t>::max()), m(1), m(1), m(2), m(4)};
+    const std::vector<m> same = decompress<m>(compress(values));
+    for (std::size_t i = 0; i < values.size(); ++i) CHECK(same[i] == values[i]);
+  }
+
+  void rejects_other_dimensions()
+  {
+    const std::vector<length<meter, double>> values = {length<meter, double>(1.0)};
+    bool thrown = false;
+    try {
+      (void)decompress<units::time<second, double>>(compress(values));
+    }
+    catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    CHECK(thrown);
+  }
+
+}  // namespace
+
+int main()
+{
+  round_trips_doubles();
+  round_trips_floats();
+  round_trips_integers();
+  round_trips_unsigned();
+  rejects_other_dimensions();
+}
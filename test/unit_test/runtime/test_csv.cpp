@@ -0,0 +1,122 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "check.h"
+#include <units/csv.h>
+#include <units/velocity.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+  using namespace units;
+
+  template<Quantity... Qs>
+  quantity_soa<Qs...> load(const std::string& text, const std::array<std::string_view, sizeof...(Qs)>& names,
+                           std::size_t threads = 1)
+  {
+    std::istringstream is(text);
+    csv_options options;
+    options.threads = threads;
+    options.block_size = 16;
+    return load_csv<Qs...>(is, names, options);
+  }
+
+  template<Quantity... Qs>
+  bool throws(const std::string& text, const std::array<std::string_view, sizeof...(Qs)>& names)
+  {
+    try {
+      load<Qs...>(text, names);
+    }
+    catch (const std::runtime_error&) {
+      return true;
+    }
+    return false;
+  }
+
+  void converts_columns()
+  {
+    const auto data = load<units::time<millisecond, std::int64_t>, velocity<meter_per_second, double>>(
+        "id,t[s],v[km/h]\n1,2,36\n2,3,72\n3,-1,-18\n", {"t", "v"}, 2);
+    CHECK(data.size() == 3);
+    CHECK(data.column<0>()[0].count() == 2000);
+    CHECK(data.column<0>()[2].count() == -1000);
+    CHECK(data.column<1>()[0].count() == 10);
+    CHECK(data.column<1>()[1].count() == 20);
+    CHECK(data.column<1>()[2].count() == -5);
+  }
+
+  void converts_exact_integral_division()
+  {
+    const auto data = load<units::time<second, int>>("t[ms]\n2000\n-3000\n", {"t"});
+    CHECK(data.column<0>()[0].count() == 2);
+    CHECK(data.column<0>()[1].count() == -3);
+  }
+
+  void loads_tiny_inputs_with_many_threads()
+  {
+    // blocks shorter than the number of chunks
+    const auto one = load<length<meter, int>>("l[m]\n7\n", {"l"}, 8);
+    CHECK(one.size() == 1);
+    CHECK(one.column<0>()[0].count() == 7);
+    const auto two = load<length<meter, int>>("l[km]\n1\n2", {"l"}, 8);
+    CHECK(two.size() == 2);
+    CHECK(two.column<0>()[1].count() == 2000);
+    CHECK(load<length<meter, int>>("l[m]\n", {"l"}, 8).size() == 0);
+  }
+
+  void rejects_unrepresentable_integral()
+  {
+    // truncation
+    CHECK(throws<units::time<second, int>>("t[ms]\n1999\n", {"t"}));
+    // overflow of the multiplication
+    CHECK(throws<units::time<nanosecond, std::int64_t>>("t[h]\n9223372036854775807\n", {"t"}));
+    // out of the range of the rep
+    CHECK(throws<length<meter, std::int16_t>>("l[km]\n40\n", {"l"}));
+    CHECK(!throws<length<meter, std::int16_t>>("l[km]\n30\n", {"l"}));
+    // negative values of unsigned reps
+    CHECK(throws<units::time<second, std::uint64_t>>("t[s]\n1\n-1\n", {"t"}));
+    CHECK(throws<length<meter, std::uint8_t>>("l[m]\n256\n", {"l"}));
+    const auto data = load<units::time<second, std::uint64_t>>("t[min]\n0\n2\n", {"t"});
+    CHECK(data.column<0>()[1].count() == 120);
+  }
+
+  void rejects_malformed()
+  {
+    CHECK(throws<length<meter, int>>("l\n1\n", {"l"}));
+    CHECK(throws<length<meter, int>>("l[kg]\n1\n", {"l"}));
+    CHECK(throws<length<meter, int>>("l[m]\n1x\n", {"l"}));
+    CHECK(throws<length<meter, int>>("x[m]\n1\n", {"l"}));
+  }
+
+}  // namespace
+
+int main()
+{
+  converts_columns();
+  converts_exact_integral_division();
+  loads_tiny_inputs_with_many_threads();
+  rejects_unrepresentable_integral();
+  rejects_malformed();
+}
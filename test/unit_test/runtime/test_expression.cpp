@@ -0,0 +1,139 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "check.h"
+#include <units/expression.h>
+#include <cmath>
+
+namespace {
+
+  using namespace units;
+
+  double eval(std::string_view source, const std::vector<expression_variable>& variables,
+              const std::vector<double>& values, std::optional<unit_id> result_unit = std::nullopt)
+  {
+    return compile_expression(source, variables, result_unit)(values);
+  }
+
+  std::size_t op_count(std::string_view source, const std::vector<expression_variable>& variables,
+                       std::optional<unit_id> result_unit = std::nullopt)
+  {
+    return compile_expression(source, variables, result_unit).ops().size();
+  }
+
+  void evaluates_arithmetic()
+  {
+    CHECK(eval("1 + 2 * 3", {}, {}) == 7);
+    CHECK(eval("(1 + 2) * 3", {}, {}) == 9);
+    CHECK(eval("-2 - -3", {}, {}) == 1);
+    CHECK(eval("1.5e3 / 2", {}, {}) == 750);
+    CHECK(eval(".25", {}, {}) == 0.25);
+  }
+
+  void converts_units()
+  {
+    CHECK(eval("x * y", {{"x", unit_id_of<meter>}, {"y", unit_id_of<meter>}}, {2, 3}) == 6);
+    CHECK(eval("x * 2", {{"x", unit_id_of<hour>}}, {1.5}, unit_id_of<minute>) == 180);
+    CHECK(eval("x + 1[km]", {{"x", unit_id_of<meter>}}, {500}) == 1500);
+    CHECK(eval("x + 500[m]", {{"x", unit_id_of<kilometer>}}, {1}, unit_id_of<meter>) == 1500);
+    CHECK(eval("d / t", {{"d", unit_id_of<kilometer>}, {"t", unit_id_of<hour>}}, {36, 1}) == 10);
+    CHECK(eval("2[km] / 500[m]", {}, {}) == 4);
+  }
+
+  void folds_constants_and_scales()
+  {
+    CHECK(op_count("1 + 2 * 3", {}) == 1);
+    CHECK(op_count("x * 3.6", {{"x", unit_id_of<meter>}}) == 1);
+    CHECK(op_count("-x", {{"x", unit_id_of<meter>}}, unit_id_of<kilometer>) == 1);
+    CHECK(op_count("d / t", {{"d", unit_id_of<kilometer>}, {"t", unit_id_of<minute>}},
+                   unit_id_of<kilometer_per_hour>) == 2);
+  }
+
+  void reports_dimension()
+  {
+    CHECK(compile_expression("d / t", {{"d", unit_id_of<meter>}, {"t", unit_id_of<second>}}).dimension() ==
+          packed_dimension::of<dimension_velocity>());
+    CHECK(compile_expression("2[m] / 3[km]", {}).dimension().dimensionless());
+  }
+
+  void reports_errors()
+  {
+    bool thrown = false;
+    try {
+      (void)compile_expression("1 + ", {});
+    }
+    catch (const expression_error& e) {
+      thrown = e.position() == 4;
+    }
+    CHECK(thrown);
+
+    thrown = false;
+    try {
+      (void)compile_expression("x + 1[s]", {{"x", unit_id_of<meter>}});
+    }
+    catch (const dimension_mismatch&) {
+      thrown = true;
+    }
+    CHECK(thrown);
+  }
+
+  void evaluates_batches()
+  {
+    // more rows than a batch and a stack deeper than the output row
+    const auto e = compile_expression("(a - b) * (a + b) / 1[km]",
+                                      {{"a", unit_id_of<meter>}, {"b", unit_id_of<meter>}}, unit_id_of<meter>);
+    CHECK(e.scratch_size() > 0);
+    const std::size_t rows = 3 * compiled_expression::batch_size + 5;
+    std::vector<double> a(rows), b(rows);
+    for (std::size_t i = 0; i < rows; ++i) {
+      a[i] = static_cast<double>(i);
+      b[i] = static_cast<double>(i % 7);
+    }
+    const std::vector<double> expected = [&] {
+      std::vector<double> r(rows);
+      for (std::size_t i = 0; i < rows; ++i) r[i] = (a[i] - b[i]) * (a[i] + b[i]) / 1000;
+      return r;
+    }();
+
+    const std::vector<double> result = e.evaluate({a.data(), b.data()}, rows);
+    for (std::size_t i = 0; i < rows; ++i) CHECK(std::abs(result[i] - expected[i]) <= 1e-9 * (1 + expected[i]));
+
+    // caller provided scratch stack
+    std::vector<double> scratch(e.scratch_size());
+    std::vector<double> out(rows);
+    const double* columns[] = {a.data(), b.data()};
+    e.evaluate(columns, rows, out.data(), scratch.data());
+    CHECK(out == result);
+  }
+
+}  // namespace
+
+int main()
+{
+  evaluates_arithmetic();
+  converts_units();
+  folds_constants_and_scales();
+  reports_dimension();
+  reports_errors();
+  evaluates_batches();
+}
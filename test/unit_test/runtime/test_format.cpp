@@ -0,0 +1,106 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "check.h"
+#include <units/format.h>
+#include <units/area.h>
+#include <units/temperature.h>
+#include <units/velocity.h>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+namespace {
+
+  using namespace units;
+
+  template<typename Q>
+  std::string text(const Q& q)
+  {
+    char buffer[128];
+    auto [ptr, ec] = to_chars(std::begin(buffer), std::end(buffer), q);
+    CHECK(ec == std::errc());
+    return std::string(buffer, ptr);
+  }
+
+  template<typename Q>
+  std::string streamed(const Q& q)
+  {
+    std::ostringstream os;
+    os << q;
+    return os.str();
+  }
+
+  void writes_value_and_symbol()
+  {
+    CHECK(text(12_km) == "12 km");
+    CHECK(text(-3_m) == "-3 m");
+    CHECK(text(velocity<kilometer_per_hour, double>(12.5)) == "12.5 km/h");
+    CHECK(text(length<meter, double>(0.1)) == "0.1 m");
+    CHECK(text(length<meter, float>(0.3f)) == "0.3 m");
+    CHECK(text(area<square_kilometer, int>(2)) == "2 km²");
+    CHECK(text(quantity<dimension_divide_t<dimension_temperature, dimension_length>,
+                        unit<dimension_divide_t<dimension_temperature, dimension_length>>, int>(4)) == "4 K/m");
+    CHECK(text(quantity<dimension_length, unit<dimension_length, ratio<3>>, int>(1)) == "1 [3] m");
+  }
+
+  void round_trips_floating_point()
+  {
+    const double values[] = {1.0 / 3, 1e300, -2.5e-300, 123456789.125};
+    for (double v : values) {
+      const std::string s = text(length<meter, double>(v));
+      CHECK(std::stod(s) == v);
+    }
+  }
+
+  void reports_small_buffer()
+  {
+    char buffer[6];
+    auto res = to_chars(std::begin(buffer), std::end(buffer), 1234_km);
+    CHECK(res.ec == std::errc::value_too_large);
+    CHECK(res.ptr == std::end(buffer));
+    res = to_chars(std::begin(buffer), std::begin(buffer) + 2, 123_m);
+    CHECK(res.ec == std::errc::value_too_large);
+    res = to_chars(std::begin(buffer), std::end(buffer), 1234_m);
+    CHECK(res.ec == std::errc());
+    CHECK(std::string(std::begin(buffer), res.ptr) == "1234 m");
+  }
+
+  void formats_and_streams()
+  {
+    std::string s;
+    format_to(std::back_inserter(s), 100.0_km / 2.0_h);
+    CHECK(s == "50 km/h");
+    CHECK(streamed(2.5_m) == "2.5 m");
+    CHECK(streamed(units::time<millisecond, int>(-7)) == "-7 ms");
+  }
+
+}  // namespace
+
+int main()
+{
+  writes_value_and_symbol();
+  round_trips_floating_point();
+  reports_small_buffer();
+  formats_and_streams();
+}
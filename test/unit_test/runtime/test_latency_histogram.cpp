@@ -0,0 +1,143 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.h"
+#include <units/latency_histogram.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  using namespace units;
+  using ns = units::time<nanosecond, std::int64_t>;
+  using histogram = latency_histogram<ns>;
+  using buckets = histogram::buckets;
+
+  void records_from_many_threads()
+  {
+    histogram h(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+      threads.emplace_back([&h] {
+        for (std::int64_t i = 0; i < 100'000; ++i) h.record(ns(i % 100));
+      });
+    for (auto& t : threads) t.join();
+    const auto s = h.snapshot();
+    CHECK(s.total_count() == 800'000);
+    for (std::size_t v = 0; v < 100; ++v) CHECK(s.count_at(buckets::index(v)) == 8'000);
+    CHECK(s.min() == ns(0));
+    CHECK(s.max() == ns(99));
+
+    h.reset();
+    CHECK(h.snapshot().total_count() == 0);
+    CHECK(h.snapshot().max() == ns(0));
+  }
+
+  void finds_percentiles_at_bucket_edges()
+  {
+    // values below 2^7 have their own buckets
+    histogram h(1);
+    for (std::int64_t v = 1; v <= 100; ++v) h.record(ns(v));
+    auto s = h.snapshot();
+    CHECK(s.value_at_percentile(0) == ns(1));
+    CHECK(s.value_at_percentile(50) == ns(50));
+    CHECK(s.value_at_percentile(99) == ns(99));
+    CHECK(s.value_at_percentile(99.4) == ns(99));
+    CHECK(s.value_at_percentile(99.5) == ns(100));
+    CHECK(s.value_at_percentile(100) == ns(100));
+    CHECK(s.value_at_percentile(1000) == ns(100));
+
+    // [1000, 1007] is a single bucket of 512 <= v < 1024 (8 values wide)
+    CHECK(buckets::index(1000) == buckets::index(1007));
+    CHECK(buckets::index(1007) + 1 == buckets::index(1008));
+    CHECK(buckets::lowest_value(buckets::index(1003)) == 1000);
+    CHECK(buckets::highest_value(buckets::index(1003)) == 1007);
+    h.reset();
+    h.record(ns(999));
+    h.record(ns(1000));
+    h.record(ns(1007));
+    h.record(ns(1008));
+    s = h.snapshot();
+    CHECK(s.min() == ns(999));
+    CHECK(s.value_at_percentile(50) == ns(1007));
+    CHECK(s.value_at_percentile(75) == ns(1007));
+    CHECK(s.max() == ns(1015));
+  }
+
+  void merges_snapshots()
+  {
+    histogram a(2), b(2);
+    for (std::int64_t v = 1; v <= 50; ++v) a.record(ns(v));
+    for (std::int64_t v = 51; v <= 100; ++v) b.record(ns(v));
+    auto s = a.snapshot();
+    s += b.snapshot();
+    CHECK(s.total_count() == 100);
+    CHECK(s.min() == ns(1));
+    CHECK(s.value_at_percentile(50) == ns(50));
+    CHECK(s.max() == ns(100));
+
+    histogram::snapshot_type direct;
+    direct.record(ns(7), 3);
+    direct.record(units::time<microsecond, std::int64_t>(1));
+    s += direct;
+    CHECK(s.total_count() == 104);
+    CHECK(s.count_at(buckets::index(7)) == 4);
+    CHECK(s.count_at(buckets::index(1000)) == 1);
+  }
+
+  void records_mixed_units()
+  {
+    histogram h(1);
+    h.record(ns(5));
+    h.record(units::time<microsecond, std::int64_t>(3));
+    h.record(units::time<millisecond, std::int64_t>(2));
+    h.record(units::time<second, double>(1.0));
+    h.record(ns(-4));  // negative samples count as zero
+    const auto s = h.snapshot();
+    CHECK(s.total_count() == 5);
+    CHECK(s.count_at(buckets::index(0)) == 1);
+    CHECK(s.count_at(buckets::index(5)) == 1);
+    CHECK(s.count_at(buckets::index(3'000)) == 1);
+    CHECK(s.count_at(buckets::index(2'000'000)) == 1);
+    CHECK(s.count_at(buckets::index(1'000'000'000)) == 1);
+    CHECK(s.min() == ns(0));
+    // relative error of a bucket is below 2^-6
+    CHECK(s.max() >= ns(1'000'000'000));
+    CHECK(s.max() < ns(1'000'000'000 + 1'000'000'000 / 64));
+
+    // coarser histogram units truncate finer samples
+    latency_histogram<units::time<microsecond, std::int64_t>> us(1);
+    us.record(ns(2'999));
+    us.record(units::time<millisecond, std::int64_t>(1));
+    CHECK(us.snapshot().min() == units::time<microsecond, std::int64_t>(2));
+    CHECK(us.snapshot().max() == units::time<microsecond, std::int64_t>(1'007));  // bucket [1000, 1007]
+  }
+
+}  // namespace
+
+int main()
+{
+  records_from_many_threads();
+  finds_percentiles_at_bucket_edges();
+  merges_snapshots();
+  records_mixed_units();
+}
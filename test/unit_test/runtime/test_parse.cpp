@@ -0,0 +1,137 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "check.h"
+#include <units/parse.h>
+#include <string_view>
+
+namespace {
+
+  using namespace units;
+
+  template<typename Q>
+  std::from_chars_result parse(std::string_view text, Q& value)
+  {
+    return from_chars(text.data(), text.data() + text.size(), value);
+  }
+
+  void parses_integral()
+  {
+    length<meter, std::int64_t> l(-1);
+    auto res = parse("12 km, next", l);
+    CHECK(res.ec == std::errc());
+    CHECK(l == 12000_m);
+    CHECK(std::string_view(res.ptr) == ", next");
+
+    units::time<millisecond, int> t;
+    CHECK(parse("300ms", t).ec == std::errc());
+    CHECK(t.count() == 300);
+    CHECK(parse("2 s", t).ec == std::errc());
+    CHECK(t.count() == 2000);
+    CHECK(parse("3000 us", t).ec == std::errc());
+    CHECK(t.count() == 3);
+  }
+
+  void rejects_inexact_integral()
+  {
+    units::time<second, int> t(7);
+    const std::string_view text = "1999 ms";
+    auto res = parse(text, t);
+    CHECK(res.ec == std::errc::result_out_of_range);
+    CHECK(res.ptr == text.data());
+    CHECK(t.count() == 7);
+
+    length<kilometer, int> l(7);
+    CHECK(parse("1500 m", l).ec == std::errc::result_out_of_range);
+    CHECK(parse("2000 m", l).ec == std::errc());
+    CHECK(l.count() == 2);
+  }
+
+  void rejects_out_of_range()
+  {
+    length<meter, std::int8_t> small(1);
+    CHECK(parse("1 km", small).ec == std::errc::result_out_of_range);
+    CHECK(small.count() == 1);
+    length<millimeter, std::int64_t> big;
+    CHECK(parse("9223372036854775807 km", big).ec == std::errc::result_out_of_range);
+  }
+
+  void checks_the_sign_of_unsigned()
+  {
+    units::time<second, std::uint64_t> t(7);
+    CHECK(parse("-5 s", t).ec == std::errc::result_out_of_range);
+    CHECK(parse("-1000 ms", t).ec == std::errc::result_out_of_range);
+    CHECK(t.count() == 7);
+    CHECK(parse("5 min", t).ec == std::errc());
+    CHECK(t.count() == 300);
+    CHECK(parse("0 s", t).ec == std::errc());
+    CHECK(t.count() == 0);
+
+    length<meter, std::uint8_t> small(1);
+    CHECK(parse("255 m", small).ec == std::errc());
+    CHECK(small.count() == 255);
+    CHECK(parse("256 m", small).ec == std::errc::result_out_of_range);
+    CHECK(small.count() == 255);
+  }
+
+  void rejects_invalid()
+  {
+    length<meter, int> l(5);
+    CHECK(parse("km", l).ec == std::errc::invalid_argument);
+    CHECK(parse("12 kg", l).ec == std::errc::invalid_argument);
+    CHECK(parse("12", l).ec == std::errc::invalid_argument);
+    CHECK(parse("12 s", l).ec == std::errc::invalid_argument);
+    CHECK(l.count() == 5);
+  }
+
+  void parses_floating_point()
+  {
+    velocity<meter_per_second, double> v;
+    CHECK(parse("36 km/h", v).ec == std::errc());
+    CHECK(v.count() == 10);
+    CHECK(parse("-2.5e1 m/s", v).ec == std::errc());
+    CHECK(v.count() == -25);
+
+    units::time<second, double> t;
+    CHECK(parse("1999 ms", t).ec == std::errc());
+    CHECK(t.count() == 1.999);
+    CHECK(parse(".5 s", t).ec == std::errc());
+    CHECK(t.count() == 0.5);
+    CHECK(parse("-. s", t).ec == std::errc::invalid_argument);
+
+    length<meter, float> f;
+    CHECK(parse("1.5 km", f).ec == std::errc());
+    CHECK(f.count() == 1500.0f);
+  }
+
+}  // namespace
+
+int main()
+{
+  parses_integral();
+  rejects_inexact_integral();
+  rejects_out_of_range();
+  checks_the_sign_of_unsigned();
+  rejects_invalid();
+  parses_floating_point();
+}
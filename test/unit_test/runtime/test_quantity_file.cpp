@@ -0,0 +1,192 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.h"
+#include <units/quantity_file.h>
+#include <units/length.h>
+#include <units/time.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef UNITS_HAS_MMAP
+
+namespace {
+
+  using namespace units;
+
+  // temporary file removed at the end of the scope
+  class temp_file {
+    std::string path_;
+
+  public:
+    temp_file()
+    {
+      char name[] = "/tmp/units_quantity_file_XXXXXX";
+      const int fd = ::mkstemp(name);
+      CHECK(fd >= 0);
+      ::close(fd);
+      path_ = name;
+    }
+    temp_file(const temp_file&) = delete;
+    temp_file& operator=(const temp_file&) = delete;
+    ~temp_file() { std::remove(path_.c_str()); }
+
+    [[nodiscard]] const std::string& path() const noexcept { return path_; }
+  };
+
+  template<typename F>
+  bool throws(F f)
+  {
+    try {
+      f();
+    }
+    catch (const std::runtime_error&) {
+      return true;
+    }
+    return false;
+  }
+
+  using km = length<kilometer, std::int64_t>;
+
+  void writes_and_maps()
+  {
+    temp_file file;
+    std::vector<km> values;
+    for (std::int64_t i = -500; i < 1'500; ++i) values.emplace_back(i * 3);
+    write_quantities(file.path(), quantity_span<const km>(values.data(), values.size()));
+
+    const mapped_quantity_file mapped(file.path());
+    CHECK(mapped.size() == values.size());
+    CHECK(mapped.header().data_offset == 64);
+    CHECK(mapped.metadata() == make_quantity_metadata<km>());
+    CHECK(mapped.holds<km>());
+    CHECK(!mapped.holds<length<meter, std::int64_t>>());
+
+    // zero-copy view of the mapping
+    const quantity_span<const km> view = mapped.view<km>();
+    CHECK(view.size() == values.size());
+    CHECK(reinterpret_cast<std::uintptr_t>(view.data()) % 64 == 0);
+    for (std::size_t i = 0; i < values.size(); ++i) CHECK(view[i] == values[i]);
+
+    // converting view
+    const auto meters = mapped.read<length<meter, std::int64_t>>();
+    CHECK(meters.size() == values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) CHECK(meters[i].count() == values[i].count() * 1'000);
+    std::vector<length<meter, std::int64_t>> copy(10);
+    meters.copy_to(quantity_span<length<meter, std::int64_t>>(copy.data(), copy.size()), 500);
+    CHECK(copy[0].count() == 0);
+    CHECK(copy[9].count() == 27'000);
+
+    // moving keeps the mapping
+    mapped_quantity_file moved(file.path());
+    mapped_quantity_file other = std::move(moved);
+    CHECK(other.view<km>()[1'000] == km(1'500));
+  }
+
+  void maps_floating_point()
+  {
+    temp_file file;
+    using s = units::time<second, double>;
+    const std::vector<s> values = {s(0.5), s(-1.25), s(3600.0)};
+    write_quantities(file.path(), quantity_span<const s>(values.data(), values.size()));
+    const mapped_quantity_file mapped(file.path());
+    CHECK(mapped.view<s>()[1] == s(-1.25));
+    const auto ms = mapped.read<units::time<millisecond, double>>();
+    CHECK(ms[0].count() == 500.0);
+    CHECK(ms[2].count() == 3'600'000.0);
+  }
+
+  void maps_empty_files()
+  {
+    temp_file file;
+    write_quantities(file.path(), quantity_span<const km>());
+    const mapped_quantity_file mapped(file.path());
+    CHECK(mapped.size() == 0);
+    CHECK(mapped.view<km>().empty());
+    CHECK(mapped.read<length<meter, std::int64_t>>().empty());
+  }
+
+  void rejects_mismatches()
+  {
+    temp_file file;
+    const std::vector<km> values = {km(1), km(2)};
+    write_quantities(file.path(), quantity_span<const km>(values.data(), values.size()));
+    const mapped_quantity_file mapped(file.path());
+    // other unit
+    CHECK(throws([&] { (void)mapped.view<length<meter, std::int64_t>>(); }));
+    // other rep
+    CHECK(throws([&] { (void)mapped.view<length<kilometer, std::int32_t>>(); }));
+    CHECK(throws([&] { (void)mapped.read<length<meter, double>>(); }));
+    // other dimension
+    CHECK(throws([&] { (void)mapped.view<units::time<second, std::int64_t>>(); }));
+    CHECK(throws([&] { (void)mapped.read<units::time<second, std::int64_t>>(); }));
+  }
+
+  void rejects_invalid_files()
+  {
+    const auto maps = [](const std::string& content) {
+      temp_file file;
+      std::ofstream(file.path(), std::ios::binary) << content;
+      return throws([&] { mapped_quantity_file mapped(file.path()); });
+    };
+    CHECK(maps(""));
+    CHECK(maps(std::string(sizeof(quantity_file_header), 'x')));  // no magic
+
+    // header promising more values than the file holds
+    std::ostringstream os;
+    const std::vector<km> values = {km(1), km(2), km(3)};
+    write_quantities(os, quantity_span<const km>(values.data(), values.size()));
+    const std::string content = os.str();
+    CHECK(!maps(content));
+    CHECK(maps(content.substr(0, content.size() - 1)));
+
+    bool missing = false;
+    try {
+      mapped_quantity_file mapped("/nonexistent/units_quantity_file");
+    }
+    catch (const std::system_error&) {
+      missing = true;
+    }
+    CHECK(missing);
+  }
+
+}  // namespace
+
+int main()
+{
+  writes_and_maps();
+  maps_floating_point();
+  maps_empty_files();
+  rejects_mismatches();
+  rejects_invalid_files();
+}
+
+#else
+
+int main() {}
+
+#endif  // UNITS_HAS_MMAP
@@ -0,0 +1,127 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "check.h"
+#include <units/area.h>
+#include <units/quantity_grid.h>
+#include <units/temperature.h>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+  using namespace units;
+  using field = quantity_grid<temperature<kelvin, double>>;
+
+  // T(x, y) = x^2 + 3y with x, y in meters
+  field make_field(std::size_t rows, std::size_t cols, double spacing)
+  {
+    field f(rows, cols);
+    for (std::size_t i = 0; i < rows; ++i)
+      for (std::size_t j = 0; j < cols; ++j) {
+        const double x = static_cast<double>(j) * spacing;
+        const double y = static_cast<double>(i) * spacing;
+        f(i, j) = temperature<kelvin, double>(x * x + 3 * y);
+      }
+    return f;
+  }
+
+  void gradient_with_integral_spacing()
+  {
+    const field f = make_field(5, 6, 2);
+    quantity_grid<gradient_t<temperature<kelvin, double>, length<meter, double>>> gx(5, 6), gy(5, 6);
+    gradient(f.view(), length<meter, int>(2), length<meter, int>(2), gx.view(), gy.view());
+    for (std::size_t i = 1; i < 4; ++i)
+      for (std::size_t j = 1; j < 5; ++j) {
+        CHECK(std::abs(gx(i, j).count() - 2 * 2.0 * static_cast<double>(j)) < 1e-9);
+        CHECK(std::abs(gy(i, j).count() - 3) < 1e-9);
+      }
+  }
+
+  void laplacian_with_integral_spacing()
+  {
+    const field f = make_field(4, 4, 1);
+    quantity_grid<laplacian_t<temperature<kelvin, double>, length<meter, double>>> out(4, 4);
+    laplacian(f.view(), length<meter, int>(1), length<meter, int>(1), out.view());
+    CHECK(out(1, 1).count() == 2);
+    CHECK(out(2, 2).count() == 2);
+    CHECK(out(0, 0).count() == 0);
+  }
+
+  void pool_matches_serial()
+  {
+    const field f = make_field(67, 2100, 0.5);
+    using lap = laplacian_t<temperature<kelvin, double>, length<meter, double>>;
+    quantity_grid<lap> serial(67, 2100), parallel(67, 2100);
+    thread_pool pool(4);
+    laplacian(f.view(), 0.5_m, 0.5_m, serial.view());
+    for (int run = 0; run < 3; ++run) {
+      laplacian(f.view(), 0.5_m, 0.5_m, parallel.view(), &pool);
+      for (std::size_t i = 0; i < 67; ++i)
+        for (std::size_t j = 0; j < 2100; ++j) CHECK(serial(i, j) == parallel(i, j));
+    }
+  }
+
+  void pool_covers_range_once()
+  {
+    thread_pool pool(3);
+    CHECK(pool.size() == 3);
+    for (std::size_t count : {0, 1, 2, 3, 10, 1000}) {
+      std::vector<std::atomic<int>> hits(count);
+      pool.parallel_for(0, count, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) ++hits[i];
+      });
+      for (auto& h : hits) CHECK(h == 1);
+    }
+  }
+
+  void pool_rethrows()
+  {
+    thread_pool pool(2);
+    bool thrown = false;
+    try {
+      pool.parallel_for(0, 10, [](std::size_t first, std::size_t) {
+        if (first == 0) throw std::runtime_error("band");
+      });
+    }
+    catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    CHECK(thrown);
+    int calls = 0;
+    pool.parallel_for(0, 1, [&](std::size_t, std::size_t) { ++calls; });
+    CHECK(calls == 1);
+  }
+
+}  // namespace
+
+int main()
+{
+  gradient_with_integral_spacing();
+  laplacian_with_integral_spacing();
+  pool_matches_serial();
+  pool_covers_range_once();
+  pool_rethrows();
+}
@@ -0,0 +1,181 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "check.h"
+#include <units/quantity_log.h>
+#include <units/length.h>
+#include <units/time.h>
+#include <units/velocity.h>
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  using namespace units;
+
+  const log_format distance_format("distance: {}");
+  const log_format timeout_format("timeout {} expired");
+
+  std::vector<std::string> decode(const std::string& log)
+  {
+    std::istringstream is(log);
+    std::ostringstream os;
+    const std::size_t count = decode_log(is, os);
+    std::vector<std::string> lines;
+    std::istringstream text(os.str());
+    for (std::string line; std::getline(text, line);) lines.push_back(line);
+    CHECK(lines.size() == count);
+    return lines;
+  }
+
+  void round_trip()
+  {
+    quantity_logger logger;
+    CHECK(logger.log(distance_format, length<kilometer, double>(2.5)));
+    CHECK(logger.log(timeout_format, units::time<millisecond, std::int64_t>(-300)));
+    CHECK(logger.log(distance_format, length<meter, float>(0.5f)));
+    std::ostringstream os;
+    CHECK(logger.write(os) == 3);
+
+    const auto lines = decode(os.str());
+    CHECK(lines.size() == 3);
+    CHECK(lines[0] == "[0] distance: 2.5 km");
+    CHECK(lines[1] == "[0] timeout -300 ms expired");
+    CHECK(lines[2] == "[0] distance: 0.5 m");
+  }
+
+  void segments_decode_alone_and_concatenated()
+  {
+    quantity_logger logger;
+    std::ostringstream first, second;
+    CHECK(logger.log(distance_format, length<meter, std::int64_t>(1)));
+    logger.write(first);
+    // a format registered after the first write
+    static const log_format late_format("late {}");
+    CHECK(logger.log(late_format, velocity<kilometer_per_hour, double>(36)));
+    logger.write(second);
+
+    CHECK(decode(first.str()) == std::vector<std::string>{"[0] distance: 1 m"});
+    CHECK(decode(second.str()) == std::vector<std::string>{"[0] late 36 km/h"});
+    CHECK(decode(first.str() + second.str()).size() == 2);
+
+    // an empty segment is still a valid log
+    std::ostringstream empty;
+    CHECK(logger.write(empty) == 0);
+    CHECK(decode(empty.str()).empty());
+  }
+
+  void rejects_malformed()
+  {
+    quantity_logger logger;
+    CHECK(logger.log(distance_format, length<meter, std::int64_t>(1)));
+    std::ostringstream os;
+    logger.write(os);
+    const std::string log = os.str();
+    for (const std::string& bad : {std::string("not a log"), log.substr(0, log.size() - 1), log + "X"}) {
+      bool thrown = false;
+      try {
+        decode(bad);
+      }
+      catch (const std::runtime_error&) {
+        thrown = true;
+      }
+      CHECK(thrown);
+    }
+  }
+
+  void recycles_thread_slots()
+  {
+    quantity_logger logger(16, 2);
+    for (int i = 0; i < 10; ++i) {
+      std::thread t([&] { CHECK(logger.log(distance_format, length<meter, std::int64_t>(i))); });
+      t.join();
+    }
+    CHECK(logger.dropped() == 0);
+    std::ostringstream os;
+    CHECK(logger.write(os) == 10);
+    auto lines = decode(os.str());
+    std::sort(lines.begin(), lines.end());
+    CHECK(lines.front().substr(0, 4) == "[0] " || lines.front().substr(0, 4) == "[1] ");
+  }
+
+  void drops_without_free_slot()
+  {
+    quantity_logger logger(16, 1);
+    CHECK(logger.log(distance_format, length<meter, std::int64_t>(1)));
+    std::thread t([&] { CHECK(!logger.log(distance_format, length<meter, std::int64_t>(2))); });
+    t.join();
+    CHECK(logger.dropped() == 1);
+  }
+
+  void drops_when_ring_is_full()
+  {
+    quantity_logger logger(4);
+    for (int i = 0; i < 6; ++i) logger.log(distance_format, length<meter, std::int64_t>(i));
+    CHECK(logger.dropped() == 2);
+    std::ostringstream os;
+    CHECK(logger.write(os) == 4);
+  }
+
+  void thread_outlives_logger()
+  {
+    auto logger = std::make_unique<quantity_logger>(16, 1);
+    std::mutex m;
+    std::condition_variable cv;
+    bool logged = false, destroyed = false;
+    // the slot is given back when the thread exits after the logger is gone
+    std::thread t([&] {
+      CHECK(logger->log(distance_format, length<meter, std::int64_t>(1)));
+      std::unique_lock lock(m);
+      logged = true;
+      cv.notify_all();
+      cv.wait(lock, [&] { return destroyed; });
+    });
+    {
+      std::unique_lock lock(m);
+      cv.wait(lock, [&] { return logged; });
+      logger.reset();
+      destroyed = true;
+      cv.notify_all();
+    }
+    t.join();
+  }
+
+}  // namespace
+
+int main()
+{
+  round_trip();
+  segments_decode_alone_and_concatenated();
+  rejects_malformed();
+  recycles_thread_slots();
+  drops_without_free_slot();
+  drops_when_ring_is_full();
+  thread_outlives_logger();
+}
@@ -0,0 +1,105 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "check.h"
+#include <units/rate_meter.h>
+#include <cmath>
+
+namespace {
+
+  using namespace units;
+  using ms = units::time<millisecond, std::int64_t>;
+
+  void counts_in_window()
+  {
+    rate_meter meter(ms(1'600), 16, 1);
+    CHECK(meter.window() == ms(1'600));
+    meter.record_at(ms(1'000), 3);
+    meter.record_at(ms(1'050));
+    meter.record_at(ms(1'500), 2);
+    CHECK(meter.count_at(ms(999)) == 0);
+    CHECK(meter.count_at(ms(1'000)) == 4);
+    CHECK(meter.count_at(ms(2'599)) == 6);
+    // the slot of 1000 ms leaves the window first
+    CHECK(meter.count_at(ms(2'600)) == 2);
+    CHECK(meter.count_at(ms(3'099)) == 2);
+    CHECK(meter.count_at(ms(3'100)) == 0);
+  }
+
+  void restarts_stale_slots()
+  {
+    rate_meter meter(ms(1'600), 16, 1);
+    meter.record_at(ms(100), 5);
+    meter.record_at(ms(1'700), 1);  // same slot one window later
+    CHECK(meter.count_at(ms(1'700)) == 1);
+    // an event older than the slot is dropped instead of being counted in the newer epoch
+    meter.record_at(ms(100), 7);
+    CHECK(meter.count_at(ms(1'700)) == 1);
+  }
+
+  void stale_slots_never_alias()
+  {
+    // 2^24 windows apart: the same slot and the same low 24 bits of the epoch
+    rate_meter meter(ms(16), 16, 1);
+    meter.record_at(ms(5), 4);
+    const ms later = ms(5) + ms(16) * (std::int64_t(1) << 24);
+    CHECK(meter.count_at(later) == 0);
+    const ms much_later = ms(5) + ms(16) * (std::int64_t(1) << 32);
+    CHECK(meter.count_at(much_later) == 0);
+  }
+
+  void reports_rate()
+  {
+    rate_meter meter(ms(1'600), 16, 1);
+    for (int i = 0; i < 16; ++i) meter.record_at(ms(10'000 + 100 * i), 10);
+    const frequency<hertz, double> rate = meter.rate_at(ms(11'599) + units::time<nanosecond, std::int64_t>(999'999));
+    CHECK(std::abs(rate.count() - 100) < 0.01);
+  }
+
+  void sums_shards()
+  {
+    rate_meter meter(ms(1'600), 4, 4);
+    meter.record_at(ms(500), 2);
+    CHECK(meter.count_at(ms(500)) == 2);
+    CHECK(meter.count_at(ms(1'000)) == 2);
+  }
+
+  void uses_the_clock()
+  {
+    rate_meter meter(units::time<second, std::int64_t>(10));
+    meter.record(3);
+    CHECK(meter.count() == 3);
+    CHECK(meter.rate().count() > 0);
+  }
+
+}  // namespace
+
+int main()
+{
+  counts_in_window();
+  restarts_stale_slots();
+  stale_slots_never_alias();
+  reports_rate();
+  sums_shards();
+  uses_the_clock();
+}
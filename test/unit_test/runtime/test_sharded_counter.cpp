@@ -0,0 +1,79 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "check.h"
+#include <units/sharded_counter.h>
+#include <units/length.h>
+#include <units/time.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  using namespace units;
+
+  void accumulates()
+  {
+    sharded_counter<units::time<microsecond, std::int64_t>> c(3);
+    CHECK(c.shards() == 4);
+    CHECK(c.load().count() == 0);
+    c.add(units::time<microsecond, std::int64_t>(1500));
+    c += units::time<microsecond, std::int64_t>(600);
+    c -= units::time<microsecond, std::int64_t>(100);
+    c.sub(units::time<microsecond, std::int64_t>(1000));
+    CHECK(c.load().count() == 1000);
+    CHECK(c.load<units::time<millisecond, std::int64_t>>().count() == 1);
+    c.reset();
+    CHECK(c.load().count() == 0);
+  }
+
+  void accumulates_floating_point()
+  {
+    sharded_counter<length<meter, double>> c(1);
+    CHECK(c.shards() == 1);
+    c += length<meter, double>(250);
+    c += length<meter, double>(0.5);
+    CHECK(c.load().count() == 250.5);
+    CHECK(c.load<length<kilometer, double>>().count() == 0.2505);
+  }
+
+  void sums_all_threads()
+  {
+    sharded_counter<length<meter, std::int64_t>> c(2);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+      threads.emplace_back([&] {
+        for (int i = 0; i < 10'000; ++i) c += 1_m;
+      });
+    for (auto& t : threads) t.join();
+    CHECK(c.load() == 40'000_m);
+  }
+
+}  // namespace
+
+int main()
+{
+  accumulates();
+  accumulates_floating_point();
+  sums_all_threads();
+}
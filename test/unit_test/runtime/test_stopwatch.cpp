@@ -0,0 +1,88 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "check.h"
+#include <units/stopwatch.h>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+  using namespace units;
+  using ns = tsc_clock::duration;
+
+  // started by a static initializer, before main()
+  const stopwatch static_stopwatch;
+  const ns static_now = tsc_clock::now();
+
+  void clock_is_monotonic()
+  {
+    CHECK(tsc_clock::to_duration(0) == ns(0));
+    ns previous = tsc_clock::now();
+    for (int i = 0; i < 1000; ++i) {
+      const ns now = tsc_clock::now();
+      CHECK(now >= previous);
+      previous = now;
+    }
+  }
+
+  void measures_sleep()
+  {
+    stopwatch sw;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const ns elapsed = sw.elapsed();
+    CHECK(elapsed >= ns(15'000'000));
+    CHECK(elapsed < ns(2'000'000'000));
+    CHECK(sw.elapsed() >= elapsed);
+  }
+
+  void works_from_static_initializers()
+  {
+    const ns elapsed = static_stopwatch.elapsed();
+    CHECK(elapsed >= ns(0));
+    CHECK(elapsed < ns(10'000'000'000));
+    CHECK(tsc_clock::now() >= static_now);
+    tsc_clock::calibrate();
+    CHECK(static_stopwatch.elapsed() >= elapsed);
+  }
+
+  void lap_restarts()
+  {
+    stopwatch sw;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    const ns first = sw.lap();
+    CHECK(first >= ns(5'000'000));
+    CHECK(sw.elapsed() < first);
+    sw.restart();
+    CHECK(sw.elapsed() < ns(5'000'000));
+  }
+
+}  // namespace
+
+int main()
+{
+  clock_is_monotonic();
+  measures_sleep();
+  lap_restarts();
+  works_from_static_initializers();
+}
@@ -0,0 +1,132 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "check.h"
+#include <units/timer_wheel.h>
+#include <vector>
+
+namespace {
+
+  using namespace units;
+  using wheel = timer_wheel<units::time<millisecond, std::int64_t>>;
+
+  void fires_after_delay()
+  {
+    wheel w;
+    int fired = 0;
+    w.schedule(units::time<millisecond, std::int64_t>(3), [&] { ++fired; });
+    CHECK(w.advance(units::time<millisecond, std::int64_t>(2)) == 0);
+    CHECK(w.advance(units::time<millisecond, std::int64_t>(1)) == 1);
+    CHECK(fired == 1);
+    CHECK(w.empty());
+  }
+
+  void rounds_delays_up()
+  {
+    wheel w;
+    int fired = 0;
+    w.schedule(units::time<microsecond, std::int64_t>(1500), [&] { ++fired; });
+    w.tick();
+    CHECK(fired == 0);
+    w.tick();
+    CHECK(fired == 1);
+  }
+
+  void periodic_and_cancel()
+  {
+    wheel w;
+    int fired = 0;
+    const auto id = w.schedule_periodic(units::time<millisecond, std::int64_t>(1),
+                                        units::time<millisecond, std::int64_t>(2), [&] { ++fired; });
+    CHECK(w.advance(units::time<millisecond, std::int64_t>(5)) == 3);
+    CHECK(w.cancel(id));
+    CHECK(!w.cancel(id));
+    CHECK(w.advance(units::time<millisecond, std::int64_t>(10)) == 0);
+    CHECK(fired == 3);
+  }
+
+  void long_delays_cascade()
+  {
+    wheel w;
+    int fired = 0;
+    w.schedule(units::time<second, std::int64_t>(70), [&] { ++fired; });
+    CHECK(w.advance(units::time<millisecond, std::int64_t>(69'999)) == 0);
+    CHECK(w.advance(units::time<millisecond, std::int64_t>(1)) == 1);
+    CHECK(fired == 1);
+  }
+
+  void schedules_from_callback()
+  {
+    wheel w;
+    std::vector<int> order;
+    w.schedule(units::time<millisecond, std::int64_t>(1), [&] {
+      order.push_back(0);
+      // grows the node pool while this callback is running
+      for (int i = 1; i <= 100; ++i)
+        w.schedule(units::time<millisecond, std::int64_t>(i), [&order, i] { order.push_back(i); });
+    });
+    CHECK(w.advance(units::time<millisecond, std::int64_t>(1)) == 1);
+    CHECK(w.size() == 100);
+    CHECK(w.advance(units::time<millisecond, std::int64_t>(100)) == 100);
+    CHECK(order.size() == 101);
+    for (int i = 0; i <= 100; ++i) CHECK(order[i] == i);
+  }
+
+  void periodic_reschedules_from_callback()
+  {
+    wheel w;
+    int fired = 0, spawned = 0;
+    w.schedule_periodic(units::time<millisecond, std::int64_t>(1), units::time<millisecond, std::int64_t>(1), [&] {
+      ++fired;
+      for (int i = 0; i < 10; ++i) w.schedule(units::time<millisecond, std::int64_t>(1), [&] { ++spawned; });
+    });
+    w.advance(units::time<millisecond, std::int64_t>(5));
+    CHECK(fired == 5);
+    CHECK(spawned == 40);
+  }
+
+  void cancels_itself()
+  {
+    wheel w;
+    int fired = 0;
+    wheel::timer_id id{};
+    id = w.schedule_periodic(units::time<millisecond, std::int64_t>(1), units::time<millisecond, std::int64_t>(1), [&] {
+      if (++fired == 2) w.cancel(id);
+    });
+    w.advance(units::time<millisecond, std::int64_t>(10));
+    CHECK(fired == 2);
+    CHECK(w.empty());
+  }
+
+}  // namespace
+
+int main()
+{
+  fires_after_delay();
+  rounds_delays_up();
+  periodic_and_cancel();
+  long_delays_cascade();
+  schedules_from_callback();
+  periodic_reschedules_from_callback();
+  cancels_itself();
+}
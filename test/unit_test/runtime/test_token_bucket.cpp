@@ -0,0 +1,167 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "check.h"
+#include <units/token_bucket.h>
+#include <cmath>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  using namespace units;
+  using ms = units::time<millisecond, std::int64_t>;
+  using ns = units::time<nanosecond, std::int64_t>;
+
+  void starts_full_and_refills()
+  {
+    token_bucket bucket(frequency<hertz, std::int64_t>(10), units::time<second, std::int64_t>(1));
+    CHECK(bucket.capacity() == 10);
+    CHECK(bucket.refill_interval().count() == 100'000'000);
+    CHECK(bucket.available_at(ms(5'000)) == 10);
+    CHECK(bucket.try_acquire_at(ms(5'000), 4));
+    CHECK(bucket.available_at(ms(5'000)) == 6);
+    CHECK(bucket.try_acquire_up_to_at(ms(5'000), 100) == 6);
+    CHECK(!bucket.try_acquire_at(ms(5'000)));
+    CHECK(bucket.try_acquire_up_to_at(ms(5'000), 100) == 0);
+    CHECK(bucket.available_at(ms(5'099)) == 0);
+    CHECK(bucket.available_at(ms(5'100)) == 1);
+    CHECK(bucket.available_at(ms(6'000)) == 10);
+    CHECK(bucket.available_at(ms(60'000)) == 10);
+  }
+
+  void rejects_oversized_requests()
+  {
+    token_bucket bucket(frequency<hertz, std::int64_t>(1'000), units::time<second, std::int64_t>(2));
+    CHECK(bucket.capacity() == 2'000);
+    CHECK(!bucket.try_acquire_at(ms(0), 2'001));
+    CHECK(!bucket.try_acquire_at(ms(0), std::numeric_limits<std::int64_t>::max()));
+    CHECK(!bucket.try_acquire_at(ms(0), -1));
+    CHECK(bucket.available_at(ms(0)) == 2'000);
+    CHECK(bucket.try_acquire_at(ms(0), 2'000));
+    CHECK(bucket.try_acquire_up_to_at(ms(1'000), std::numeric_limits<std::int64_t>::max()) == 1'000);
+  }
+
+  void keeps_sub_nanosecond_intervals()
+  {
+    // 300 MHz: 3.33 ns per token, whole nanoseconds would give 3 ns (333 MHz)
+    token_bucket bucket(frequency<megahertz, std::int64_t>(300), ms(1));
+    CHECK(std::abs(bucket.refill_interval().count() - 10.0 / 3) < 0.001);
+    const auto close_to = [](std::int64_t value, std::int64_t expected) {
+      return std::abs(value - expected) <= expected / 1'000;
+    };
+    CHECK(close_to(bucket.capacity(), 300'000));
+    CHECK(close_to(bucket.try_acquire_up_to_at(ms(0), std::numeric_limits<std::int64_t>::max()), 300'000));
+    std::int64_t total = 0;
+    for (std::int64_t t = 1; t <= 1'000; ++t)
+      total += bucket.try_acquire_up_to_at(ns(t * 10'000), std::numeric_limits<std::int64_t>::max());
+    // 10 ms worth of tokens at 300 MHz
+    CHECK(close_to(total, 3'000'000));
+  }
+
+  void saturates_far_times()
+  {
+    token_bucket bucket(frequency<gigahertz, std::int64_t>(1), ms(1));
+    CHECK(bucket.try_acquire_at(ns(0), 1'000'000));
+    CHECK(!bucket.try_acquire_at(ns(0)));
+    const ns far(std::numeric_limits<std::int64_t>::max());
+    CHECK(bucket.available_at(far) == 1'000'000);
+    CHECK(bucket.try_acquire_at(far, 1'000'000));
+    CHECK(!bucket.try_acquire_at(far));
+  }
+
+  void refills_after_long_uptimes()
+  {
+    using h = units::time<hour, std::int64_t>;
+    token_bucket bucket(frequency<gigahertz, std::int64_t>(1), ms(1));
+    for (std::int64_t day = 0; day <= 400; ++day) {
+      const h now(day * 24);
+      CHECK(bucket.available_at(now) == 1'000'000);
+      CHECK(bucket.try_acquire_at(now, 1'000'000));
+      CHECK(!bucket.try_acquire_at(now));
+      CHECK(bucket.try_acquire_up_to_at(now + ns(500'000), 1'000'000) == 500'000);
+    }
+  }
+
+  void keeps_the_state_when_moving_the_origin()
+  {
+    // at 1 GHz the origin moves when a time gets 2^49 ns (6.5 days) past it
+    token_bucket bucket(frequency<gigahertz, std::int64_t>(1), ms(1));
+    const ns half_range((std::int64_t(1) << 49) - 1);
+    CHECK(bucket.available_at(ns(0)) == 1'000'000);
+    CHECK(bucket.try_acquire_at(ns(0)));
+    const ns before = half_range - ns(500'000);
+    CHECK(bucket.try_acquire_at(before, 1'000'000));
+    CHECK(bucket.try_acquire_up_to_at(before + ns(750'000), std::numeric_limits<std::int64_t>::max()) == 750'000);
+    CHECK(!bucket.try_acquire_at(before + ns(750'000)));
+    CHECK(bucket.available_at(before + ns(1'000'000)) == 250'000);
+  }
+
+  void refills_after_long_uptimes_concurrently()
+  {
+    // the clock goes 4 hours forward at every step so the origin moves while the threads acquire
+    token_bucket bucket(frequency<gigahertz, std::int64_t>(1), ms(1));
+    constexpr std::int64_t steps = 2'000;
+    constexpr std::int64_t step_ns = 4 * 3'600'000'000'000;
+    std::atomic<std::int64_t> clock{0};
+    std::atomic<std::int64_t> acquired{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+      threads.emplace_back([&] {
+        std::int64_t now;
+        while ((now = clock.load()) < steps * step_ns) acquired += bucket.try_acquire_up_to_at(ns(now), 1'000);
+      });
+    for (std::int64_t i = 1; i <= steps; ++i) {
+      std::this_thread::yield();
+      clock += step_ns;
+    }
+    for (auto& t : threads) t.join();
+    // never more than a full bucket per step
+    CHECK(acquired <= steps * 1'000'000);
+    CHECK(bucket.try_acquire_at(ns(steps * step_ns), 1'000'000));
+    CHECK(!bucket.try_acquire_at(ns(steps * step_ns)));
+  }
+
+  void uses_the_clock()
+  {
+    token_bucket bucket(frequency<hertz, std::int64_t>(1), units::time<second, std::int64_t>(5));
+    CHECK(bucket.available() == 5);
+    CHECK(bucket.try_acquire(5));
+    CHECK(!bucket.try_acquire());
+  }
+
+}  // namespace
+
+int main()
+{
+  starts_full_and_refills();
+  rejects_oversized_requests();
+  keeps_sub_nanosecond_intervals();
+  saturates_far_times();
+  refills_after_long_uptimes();
+  keeps_the_state_when_moving_the_origin();
+  refills_after_long_uptimes_concurrently();
+  uses_the_clock();
+}
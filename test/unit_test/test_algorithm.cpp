@@ -0,0 +1,114 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/algorithm.h>
+#include <units/length.h>
+#include <array>
+#include <limits>
+
+namespace {
+
+  using namespace units;
+
+  using m = length<meter, std::int64_t>;
+  using km = length<kilometer, std::int64_t>;
+  using um = length<meter, std::uint8_t>;
+
+  // threshold_filter (the matching reps of integral quantities)
+
+  constexpr threshold_filter lt(std::less<>{}, length<meter, std::int64_t>(1500));
+  static_assert(std::is_same_v<decltype(lt), const threshold_filter<length<meter, std::int64_t>, std::less<>>>);
+
+  static_assert(threshold_filter<km, std::less<>>(std::less<>{}, m(1500)).upper() == 1);
+  static_assert(threshold_filter<km, std::less<>>(std::less<>{}, m(2000)).upper() == 1);
+  static_assert(threshold_filter<km, std::less_equal<>>(std::less_equal<>{}, m(1500)).upper() == 1);
+  static_assert(threshold_filter<km, std::less_equal<>>(std::less_equal<>{}, m(-1500)).upper() == -2);
+  static_assert(threshold_filter<km, std::greater<>>(std::greater<>{}, m(1500)).lower() == 2);
+  static_assert(threshold_filter<km, std::greater<>>(std::greater<>{}, m(-1500)).lower() == -1);
+  static_assert(threshold_filter<km, std::greater_equal<>>(std::greater_equal<>{}, m(1500)).lower() == 2);
+  static_assert(threshold_filter<km, std::greater_equal<>>(std::greater_equal<>{}, m(2000)).lower() == 2);
+  static_assert(threshold_filter<km, std::equal_to<>>(std::equal_to<>{}, m(2000)).lower() == 2);
+  static_assert(threshold_filter<km, std::equal_to<>>(std::equal_to<>{}, m(2000)).upper() == 2);
+  static_assert(threshold_filter<m, std::greater_equal<>>(std::greater_equal<>{}, length<meter, double>(2.5)).lower() ==
+                3);
+
+  // thresholds out of the range of the rep
+
+  static_assert(!threshold_filter<um, std::less<>>(std::less<>{}, m(0))(um(0)));
+  static_assert(threshold_filter<um, std::less<>>(std::less<>{}, km(1))(um(255)));
+  static_assert(!threshold_filter<um, std::greater<>>(std::greater<>{}, km(1))(um(255)));
+  static_assert(!threshold_filter<um, std::equal_to<>>(std::equal_to<>{}, m(-1))(um(255)));
+
+  // thresholds at the limits of 64-bit reps (wider than a 64-bit product)
+
+  using mmax = std::numeric_limits<std::int64_t>;
+  using u64m = length<meter, std::uint64_t>;
+
+  static_assert(threshold_filter<m, std::less<>>(std::less<>{}, km(mmax::max()))(m(mmax::max())));
+  static_assert(!threshold_filter<m, std::less_equal<>>(std::less_equal<>{}, km(mmax::min()))(m(mmax::min())));
+  static_assert(threshold_filter<m, std::greater<>>(std::greater<>{}, km(mmax::min()))(m(mmax::min())));
+  static_assert(!threshold_filter<m, std::greater_equal<>>(std::greater_equal<>{}, km(mmax::max()))(m(mmax::max())));
+  static_assert(threshold_filter<m, std::less_equal<>>(std::less_equal<>{}, m(mmax::min())).upper() == mmax::min());
+  static_assert(!threshold_filter<m, std::less<>>(std::less<>{}, m(mmax::min()))(m(mmax::min())));
+  static_assert(!threshold_filter<m, std::greater<>>(std::greater<>{}, m(mmax::max()))(m(mmax::max())));
+  static_assert(threshold_filter<u64m, std::greater<>>(std::greater<>{}, m(-1)).lower() == 0);
+  static_assert(!threshold_filter<u64m, std::greater<>>(std::greater<>{}, km(mmax::max()))(u64m(~std::uint64_t(0))));
+  static_assert(threshold_filter<u64m, std::less<>>(std::less<>{}, km(mmax::max()))(u64m(~std::uint64_t(0))));
+  static_assert(threshold_filter<u64m, std::greater<>>(std::greater<>{}, m(mmax::max())).lower() ==
+                std::uint64_t(mmax::max()) + 1);
+  static_assert(threshold_filter<m, std::less<>>(std::less<>{}, length<meter, double>(0x1p63))(m(mmax::max())));
+  static_assert(threshold_filter<m, std::less_equal<>>(std::less_equal<>{}, length<meter, double>(-0x1p63)).upper() ==
+                mmax::min());
+  static_assert(!threshold_filter<m, std::less<>>(std::less<>{}, length<meter, double>(-0x1p63))(m(mmax::min())));
+
+  // floating-point reps
+
+  using dm = length<meter, double>;
+
+  static_assert(threshold_filter<dm, std::less<>>(std::less<>{}, km(1))(dm(999.5)));
+  static_assert(!threshold_filter<dm, std::less<>>(std::less<>{}, km(1))(dm(1000)));
+
+  // kernels
+
+  constexpr std::array<km, 5> values{km(0), km(1), km(2), km(3), km(4)};
+
+  static_assert(count_if(quantity_span<const km>(values), std::less<>{}, m(1500)) == 2);
+  static_assert(count_if(quantity_span<const km>(values), std::less_equal<>{}, m(2000)) == 3);
+  static_assert(count_if(quantity_span<const km>(values), std::greater<>{}, m(2000)) == 2);
+  static_assert(count_if(quantity_span<const km>(values), std::greater_equal<>{}, m(2000)) == 3);
+  static_assert(count_if(quantity_span<const km>(values), std::equal_to<>{}, m(2000)) == 1);
+  static_assert(count_if(quantity_span<const km>(values), std::equal_to<>{}, m(2001)) == 0);
+
+  static_assert([] {
+    std::array<bool, values.size()> out{};
+    const std::size_t n = mask(quantity_span<const km>(values), std::greater<>{}, m(2500), out.data());
+    return n == 2 && !out[0] && !out[2] && out[3] && out[4];
+  }());
+
+  static_assert([] {
+    std::array<km, 5> v = values;
+    const std::size_t n = partition(quantity_span<km>(v), std::greater_equal<>{}, m(3000));
+    return n == 2 && v[0] >= km(3) && v[1] >= km(3) && v[2] < km(3);
+  }());
+
+}  // namespace
@@ -0,0 +1,65 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/atomic_quantity.h>
+#include <units/length.h>
+#include <units/time.h>
+#include <utility>
+
+namespace {
+
+  using namespace units;
+
+  template<typename T, typename Arg>
+  concept bool fetch_addable = requires(T& t, Arg a) { t.fetch_add(a); };
+
+  using ns_counter = atomic_quantity<units::time<nanosecond, std::int64_t>>;
+  using s_counter = atomic_quantity<units::time<second, std::int64_t>>;
+  using m_counter = atomic_quantity<length<meter, double>>;
+
+  // member types
+
+  static_assert(std::is_same_v<ns_counter::value_type, units::time<nanosecond, std::int64_t>>);
+  static_assert(std::is_same_v<m_counter::rep, double>);
+
+  // lock-freedom
+
+  static_assert(ns_counter::is_always_lock_free);
+  static_assert(m_counter::is_always_lock_free == std::atomic<double>::is_always_lock_free);
+
+  // operands in other units
+
+  static_assert(fetch_addable<ns_counter, units::time<nanosecond, std::int64_t>>);
+  static_assert(fetch_addable<ns_counter, units::time<second, std::int64_t>>);
+  static_assert(fetch_addable<m_counter, length<kilometer, double>>);
+  static_assert(fetch_addable<m_counter, length<millimeter, std::int64_t>>);
+  static_assert(!fetch_addable<s_counter, units::time<millisecond, std::int64_t>>);
+  static_assert(!fetch_addable<s_counter, units::time<second, double>>);
+  static_assert(!fetch_addable<m_counter, units::time<second, double>>);
+
+  // not copyable
+
+  static_assert(!std::is_copy_constructible_v<m_counter>);
+  static_assert(!std::is_copy_assignable_v<m_counter>);
+
+}  // namespace
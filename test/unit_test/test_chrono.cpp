@@ -0,0 +1,68 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/chrono.h>
+#include <type_traits>
+
+namespace {
+
+  using namespace units;
+  using namespace std::chrono_literals;
+
+  using sys_seconds = std::chrono::time_point<std::chrono::system_clock, std::chrono::duration<std::int64_t>>;
+
+  // std::chrono::duration -> time
+
+  static_assert(std::is_same_v<decltype(to_quantity(std::chrono::duration<std::int64_t>(1))), units::time<second, std::int64_t>>);
+  static_assert(std::is_same_v<decltype(to_quantity(std::chrono::duration<std::int64_t, std::milli>(1))), units::time<millisecond, std::int64_t>>);
+  static_assert(std::is_same_v<decltype(to_quantity(std::chrono::duration<double, std::nano>(1))), units::time<nanosecond, double>>);
+  static_assert(std::is_same_v<decltype(to_quantity(std::chrono::duration<int, std::ratio<60>>(1))), units::time<minute, int>>);
+  static_assert(to_quantity(2s) == 2_s);
+  static_assert(to_quantity(1h) == 3600_s);
+  static_assert(to_quantity(1500ms) == 1500_ms);
+  static_assert(to_quantity(1.5s) == 1500_ms);
+
+  // time -> std::chrono::duration
+
+  static_assert(std::is_same_v<decltype(to_std_duration(1_s)), std::chrono::duration<std::int64_t>>);
+  static_assert(std::is_same_v<decltype(to_std_duration(1_us)), std::chrono::duration<std::int64_t, std::micro>>);
+  static_assert(std::is_same_v<decltype(to_std_duration(1.0_h)), std::chrono::duration<long double, std::ratio<3600>>>);
+  static_assert(to_std_duration(2_s) == 2s);
+  static_assert(to_std_duration(1_min) == 60s);
+  static_assert(to_std_duration(10_ns) == 10ns);
+
+  // round trip only copies the count
+
+  static_assert(std::is_same_v<decltype(to_quantity(to_std_duration(1_ms))), decltype(1_ms)>);
+  static_assert(to_quantity(to_std_duration(42_ms)).count() == 42);
+  static_assert(to_std_duration(to_quantity(42ms)).count() == 42);
+  static_assert(sizeof(decltype(1_ms)) == sizeof(std::chrono::milliseconds::rep));
+  static_assert(std::is_trivially_copyable_v<decltype(1_ms)>);
+
+  // std::chrono::time_point
+
+  static_assert(time_since_epoch(sys_seconds(10s)) == 10_s);
+  static_assert(to_std_time_point<std::chrono::system_clock>(10_s) == sys_seconds(10s));
+  static_assert(time_since_epoch(to_std_time_point<std::chrono::steady_clock>(5_ms)) == 5_ms);
+
+}  // namespace
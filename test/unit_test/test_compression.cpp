@@ -0,0 +1,59 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/compression.h>
+#include <units/length.h>
+#include <units/time.h>
+
+namespace {
+
+  using namespace units;
+
+  // zigzag mapping of delta-of-deltas
+
+  static_assert(detail::zigzag_encode(0) == 0);
+  static_assert(detail::zigzag_encode(-1) == 1);
+  static_assert(detail::zigzag_encode(1) == 2);
+  static_assert(detail::zigzag_encode(-64) == 127);
+  static_assert(detail::zigzag_decode(detail::zigzag_encode(-1'000'000)) == -1'000'000);
+  static_assert(detail::zigzag_decode(detail::zigzag_encode(std::numeric_limits<std::int64_t>::min())) ==
+                std::numeric_limits<std::int64_t>::min());
+
+  // codecs
+
+  static_assert(std::is_same_v<detail::quantity_codec<std::int32_t>, detail::delta_of_delta_codec>);
+  static_assert(std::is_same_v<detail::quantity_codec<std::uint64_t>, detail::delta_of_delta_codec>);
+  static_assert(std::is_same_v<detail::quantity_codec<float>, detail::xor_codec<32>>);
+  static_assert(std::is_same_v<detail::quantity_codec<double>, detail::xor_codec<64>>);
+
+  // encoders
+
+  template<typename Q>
+  concept bool compressible = requires(quantity_encoder<Q> e, Q q) {
+    e.push(q);
+  };
+
+  static_assert(compressible<units::time<millisecond, std::int64_t>>);
+  static_assert(compressible<length<meter, float>>);
+
+}  // namespace
@@ -0,0 +1,47 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/conversion_cache.h>
+#include <type_traits>
+
+namespace {
+
+  using namespace units;
+
+  // lookups
+
+  static_assert(std::is_same_v<decltype(std::declval<const conversion_cache<>&>().find(0, 0)), std::optional<double>>);
+  static_assert(std::is_same_v<decltype(std::declval<conversion_cache<>&>().factor(0, 0)), double>);
+  static_assert(noexcept(std::declval<const conversion_cache<>&>().find(0, 0)));
+
+  // custom registry
+
+  using small_registry = basic_unit_registry<unit_list<meter, kilometer>>;
+  static_assert(std::is_same_v<decltype(std::declval<conversion_cache<small_registry>&>().factor(0, 1)), double>);
+
+  // not copyable
+
+  static_assert(!std::is_copy_constructible_v<conversion_cache<>>);
+  static_assert(!std::is_copy_assignable_v<conversion_cache<>>);
+
+}  // namespace
@@ -0,0 +1,47 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/csv.h>
+#include <units/velocity.h>
+
+namespace {
+
+  using namespace units;
+
+  // header fields
+
+  static_assert(detail::csv_split_header_field("speed[km/h]").first == "speed");
+  static_assert(detail::csv_split_header_field("speed[km/h]").second == "km/h");
+  static_assert(detail::csv_split_header_field(" speed [ km/h ]\r").first == "speed");
+  static_assert(detail::csv_split_header_field(" speed [ km/h ]\r").second == "km/h");
+  static_assert(detail::csv_split_header_field("id").first == "id");
+  static_assert(detail::csv_split_header_field("id").second.empty());
+  static_assert(detail::csv_split_header_field("a[b").second.empty());
+
+  // numbers parsed before the conversion
+
+  static_assert(std::is_same_v<detail::csv_number<velocity<meter_per_second, float>>, double>);
+  static_assert(std::is_same_v<detail::csv_number<velocity<meter_per_second, long double>>, long double>);
+  static_assert(std::is_same_v<detail::csv_number<length<meter, int>>, std::intmax_t>);
+
+}  // namespace
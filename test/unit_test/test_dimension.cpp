@@ -68,5 +68,14 @@ namespace {
   static_assert(
       std::is_same_v<dimension_divide_t<dimension<e<0, 1>>, dimension<e<1, 1>>>, dimension<e<0, 1>, e<1, -1>>>);
   static_assert(std::is_same_v<dimension_divide_t<dimension<e<0, 1>>, dimension<e<0, 1>>>, dimension<>>);
+  static_assert(std::is_same_v<dimension_divide_t<dimension<e<4, 1>, e<0, -1>>, dimension<e<0, 1>>>,
+                               dimension<e<4, 1>, e<0, -2>>>);
+
+  // dimension_exponent
+
+  static_assert(dimension_exponent<dimension<e<0, 1>, e<1, -2>>, dim_id<0>> == 1);
+  static_assert(dimension_exponent<dimension<e<0, 1>, e<1, -2>>, dim_id<1>> == -2);
+  static_assert(dimension_exponent<dimension<e<0, 1>, e<1, -2>>, dim_id<2>> == 0);
+  static_assert(dimension_exponent<dimension<>, dim_id<0>> == 0);
 
 }  // namespace
@@ -0,0 +1,78 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/dynamic_quantity.h>
+#include <units/area.h>
+#include <units/frequency.h>
+#include <units/velocity.h>
+#include <type_traits>
+
+namespace {
+
+  using namespace units;
+
+  // packed_dimension
+
+  constexpr packed_dimension length_dim = packed_dimension::of<dimension_length>();
+  constexpr packed_dimension time_dim = packed_dimension::of<dimension_time>();
+  constexpr packed_dimension velocity_dim = packed_dimension::of<dimension_velocity>();
+
+  static_assert(packed_dimension().dimensionless());
+  static_assert(length_dim.exponent(base_dim_length::value) == 1);
+  static_assert(velocity_dim.exponent(base_dim_length::value) == 1);
+  static_assert(velocity_dim.exponent(base_dim_time::value) == -1);
+  static_assert(velocity_dim.exponent(base_dim_mass::value) == 0);
+
+  static_assert(length_dim / time_dim == velocity_dim);
+  static_assert(velocity_dim * time_dim == length_dim);
+  static_assert(length_dim * length_dim == packed_dimension::of<dimension_area>());
+  static_assert(time_dim.inverse() == packed_dimension::of<dimension_frequency>());
+  static_assert((length_dim / length_dim).dimensionless());
+  static_assert((time_dim.inverse() * time_dim.inverse()).exponent(base_dim_time::value) == -2);
+  static_assert(length_dim != time_dim);
+
+  // dynamic_quantity
+
+  static_assert(dynamic_quantity(2_km).value() == 2);
+  static_assert(dynamic_quantity(2_km).magnitude() == 1000);
+  static_assert(dynamic_quantity(2_km).coherent_value() == 2000);
+  static_assert(dynamic_quantity(2_km) == dynamic_quantity(2000_m));
+  static_assert((dynamic_quantity(2_km) + dynamic_quantity(500_m)).value() == 2.5);
+  static_assert(dynamic_quantity(1_km) < dynamic_quantity(1001_m));
+  static_assert((dynamic_quantity(100_km) / dynamic_quantity(2_h)).dimension() == velocity_dim);
+
+  // quantity_cast
+
+  static_assert(quantity_cast<length<meter, int>>(dynamic_quantity(2_km)) == 2000_m);
+  static_assert(quantity_cast<velocity<kilometer_per_hour, double>>(dynamic_quantity(100.0_km) /
+                                                                    dynamic_quantity(2.0_h)) == 50.0_kmph);
+
+  template<typename To, typename From>
+  concept bool castable = requires(From f) { quantity_cast<To>(f); };
+
+  static_assert(castable<length<meter, double>, dynamic_quantity>);
+  static_assert(castable<length<meter, double>, length<kilometer, double>>);
+  static_assert(!castable<length<meter, double>, units::time<second, double>>);
+  static_assert(!std::is_convertible_v<length<meter, double>, dynamic_quantity>);
+
+}  // namespace
@@ -0,0 +1,60 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/format.h>
+#include <units/area.h>
+#include <units/frequency.h>
+#include <units/mass.h>
+#include <units/temperature.h>
+#include <units/velocity.h>
+
+namespace {
+
+  using namespace units;
+
+  // named units
+
+  static_assert(unit_text<meter> == "m");
+  static_assert(unit_text<kilometer_per_hour> == "km/h");
+  static_assert(unit_text<square_kilometer> == "km²");
+
+  // prefixed base units
+
+  static_assert(unit_text<unit<dimension_length, ratio<1, 1'000'000>>> == "µm");
+  static_assert(unit_text<unit<dimension_mass, ratio<1, 1'000'000>>> == "mg");
+  static_assert(unit_text<unit<dimension_mass, ratio<1, 1'000>>> == "g");
+  static_assert(unit_text<unit<dimension_time, ratio<1, 1'000'000'000'000>>> == "ps");
+
+  // derived units
+
+  static_assert(unit_text<unit<dimension_divide_t<dimension_temperature, dimension_length>>> == "K/m");
+  static_assert(unit_text<unit<dimension_divide_t<dimension_temperature, dimension_area>>> == "K/m²");
+  static_assert(unit_text<unit<dimension_multiply_t<dimension_length, dimension_mass>>> == "m⋅kg");
+  static_assert(unit_text<unit<dim_invert_t<dimension_multiply_t<dimension_length, dimension_time>>>> == "1/(m⋅s)");
+
+  // scaled units
+
+  static_assert(unit_text<unit<dimension_length, ratio<3>>> == "[3] m");
+  static_assert(unit_text<unit<dimension_velocity, ratio<1, 60>>> == "[1/60] m/s");
+
+}  // namespace
@@ -0,0 +1,61 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/latency_histogram.h>
+
+namespace {
+
+  using namespace units;
+
+  using buckets = detail::log_linear_buckets<7>;
+
+  // small values are exact
+
+  static_assert(buckets::index(0) == 0);
+  static_assert(buckets::index(1) == 1);
+  static_assert(buckets::index(127) == 127);
+  static_assert(buckets::lowest_value(100) == 100 && buckets::highest_value(100) == 100);
+
+  // larger values are grouped by the highest set bit
+
+  static_assert(buckets::index(128) == 128);
+  static_assert(buckets::index(129) == 128);
+  static_assert(buckets::index(130) == 129);
+  static_assert(buckets::lowest_value(128) == 128 && buckets::highest_value(128) == 129);
+  static_assert(buckets::index(255) == 191);
+  static_assert(buckets::index(256) == 192);
+  static_assert(buckets::lowest_value(192) == 256 && buckets::highest_value(192) == 259);
+
+  // buckets are contiguous and cover the whole range
+
+  static_assert(buckets::highest_value(127) + 1 == buckets::lowest_value(128));
+  static_assert(buckets::highest_value(191) + 1 == buckets::lowest_value(192));
+  static_assert(buckets::index(std::numeric_limits<std::uint64_t>::max()) == buckets::count - 1);
+  static_assert(buckets::highest_value(buckets::count - 1) == std::numeric_limits<std::uint64_t>::max());
+
+  // relative error
+
+  static_assert(buckets::highest_value(buckets::index(1'000'000)) - buckets::lowest_value(buckets::index(1'000'000)) <
+                1'000'000 / 64);
+
+}  // namespace
@@ -0,0 +1,59 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/parse.h>
+
+namespace {
+
+  using namespace units;
+
+  // unit_symbol
+
+  static_assert(unit_symbol<meter> == "m");
+  static_assert(unit_symbol<kilometer_per_hour> == "km/h");
+  static_assert(unit_symbol<square_meter> == "m²");
+  static_assert(unit_symbol<unit<dimension_length, ratio<3>>>.empty());
+
+  // unit_symbol_table
+
+  static_assert(unit_symbol_table<meter>::size() == 8);
+  static_assert(unit_symbol_table<second>::size() == 7);
+  static_assert(unit_symbol_table<square_meter>::size() == 10);
+
+  static_assert(unit_symbol_table<meter>::find("m")->num == 1);
+  static_assert(unit_symbol_table<meter>::find("km")->num == 1000);
+  static_assert(unit_symbol_table<meter>::find("km")->den == 1);
+  static_assert(unit_symbol_table<kilometer>::find("m")->num == 1);
+  static_assert(unit_symbol_table<kilometer>::find("m")->den == 1000);
+  static_assert(unit_symbol_table<meter_per_second>::find("km/h")->num == 5);
+  static_assert(unit_symbol_table<meter_per_second>::find("km/h")->den == 18);
+  static_assert(unit_symbol_table<millisecond>::find("us")->den == 1000);
+  static_assert(unit_symbol_table<millisecond>::find("µs")->den == 1000);
+  static_assert(unit_symbol_table<square_meter>::find("km^2")->num == 1'000'000);
+
+  static_assert(unit_symbol_table<meter>::find("kg") == nullptr);
+  static_assert(unit_symbol_table<meter>::find("") == nullptr);
+  static_assert(unit_symbol_table<meter>::find("M") == nullptr);
+  static_assert(unit_symbol_table<second>::find("m") == nullptr);
+
+}  // namespace
@@ -183,6 +183,12 @@ namespace {
   static_assert((7_m %= 2).count() == 1);
   static_assert((7_m %= 2_m).count() == 1);
 
+  template<typename T>
+  concept bool modulo_assignable = requires(T t) { t %= t; };
+
+  static_assert(modulo_assignable<length<meter, int>>);
+  static_assert(!modulo_assignable<length<meter, double>>);
+
   // non-member arithmetic operators
 
   static_assert(std::is_same_v<decltype(length<meter, int>() + length<meter, double>()), quantity<dimension_length, meter, double>>);
@@ -0,0 +1,62 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/quantity_file.h>
+#include <units/length.h>
+#include <units/velocity.h>
+#include <cstddef>
+
+namespace {
+
+  using namespace units;
+
+  // metadata
+
+  constexpr quantity_metadata km_double = make_quantity_metadata<length<kilometer, double>>();
+  static_assert(km_double.kind == rep_kind::floating_point);
+  static_assert(km_double.rep_size == sizeof(double));
+  static_assert(km_double.exponents[0] == 1 && km_double.exponents[2] == 0);
+  static_assert(km_double.ratio_num == 1000 && km_double.ratio_den == 1);
+
+  constexpr quantity_metadata kmph_int = make_quantity_metadata<velocity<kilometer_per_hour, std::int32_t>>();
+  static_assert(kmph_int.kind == rep_kind::signed_integer);
+  static_assert(kmph_int.rep_size == sizeof(std::int32_t));
+  static_assert(kmph_int.exponents[0] == 1 && kmph_int.exponents[2] == -1);
+  static_assert(kmph_int.ratio_num == 5 && kmph_int.ratio_den == 18);
+
+  static_assert(make_quantity_metadata<velocity<meter_per_second, unsigned>>().kind == rep_kind::unsigned_integer);
+
+  // compatibility
+
+  static_assert(km_double == make_quantity_metadata<length<kilometer, double>>());
+  static_assert(km_double != make_quantity_metadata<length<meter, double>>());
+  static_assert(km_double.is_convertible_to(make_quantity_metadata<length<meter, double>>()));
+  static_assert(!km_double.is_convertible_to(make_quantity_metadata<length<meter, float>>()));
+  static_assert(!km_double.is_convertible_to(make_quantity_metadata<velocity<meter_per_second, double>>()));
+
+  // header layout
+
+  static_assert(sizeof(quantity_file_header) == 64);
+  static_assert(offsetof(quantity_file_header, metadata) == 16);
+
+}  // namespace
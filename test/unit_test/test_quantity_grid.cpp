@@ -0,0 +1,72 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/quantity_grid.h>
+#include <units/area.h>
+#include <units/temperature.h>
+#include <array>
+
+namespace {
+
+  using namespace units;
+
+  // result types of the differential kernels
+
+  static_assert(std::is_same_v<gradient_t<temperature<kelvin, double>, length<meter, double>>::dimension,
+                               dimension_divide_t<dimension_temperature, dimension_length>>);
+  static_assert(std::is_same_v<laplacian_t<temperature<kelvin, double>, length<meter, double>>::dimension,
+                               dimension_divide_t<dimension_temperature, dimension_area>>);
+
+  // element access
+
+  static_assert([] {
+    std::array<length<meter, int>, 6> a{};
+    quantity_grid_view<length<meter, int>> v(a.data(), 2, 3);
+    v(1, 2) = 5_m;
+    quantity_grid_view<const length<meter, int>> c = v;
+    return c.extent(0) == 2 && c.extent(1) == 3 && a[5] == 5_m && c.row(1)[2] == 5_m &&
+           c.subgrid(1, 1, 1, 2)(0, 1) == 5_m;
+  }());
+
+  // dimension checks of the kernels
+
+  using field = quantity_grid_view<const temperature<kelvin, double>>;
+  using length_m = length<meter, double>;
+
+  template<typename Out>
+  concept bool gradient_output = requires(field f, Out o) {
+    gradient(f, length_m(1), length_m(1), o, o);
+  };
+
+  template<typename Out>
+  concept bool laplacian_output = requires(field f, Out o) {
+    laplacian(f, length_m(1), length_m(1), o);
+  };
+
+  static_assert(gradient_output<quantity_grid_view<gradient_t<temperature<kelvin, double>, length_m>>>);
+  static_assert(!gradient_output<quantity_grid_view<temperature<kelvin, double>>>);
+  static_assert(!gradient_output<quantity_grid_view<const gradient_t<temperature<kelvin, double>, length_m>>>);
+  static_assert(laplacian_output<quantity_grid_view<laplacian_t<temperature<kelvin, double>, length_m>>>);
+  static_assert(!laplacian_output<quantity_grid_view<gradient_t<temperature<kelvin, double>, length_m>>>);
+
+}  // namespace
@@ -0,0 +1,53 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/quantity_log.h>
+#include <units/length.h>
+#include <units/time.h>
+
+namespace {
+
+  using namespace units;
+
+  struct furlong : unit<dimension_length, ratio<201'168, 1'000>> {};
+
+  // Loggable
+
+  static_assert(Loggable<length<meter, double>>);
+  static_assert(Loggable<length<kilometer, float>>);
+  static_assert(Loggable<units::time<nanosecond, std::int64_t>>);
+  static_assert(Loggable<units::time<second, std::uint8_t>>);
+  static_assert(!Loggable<length<meter, long double>>);  // does not fit the record
+  static_assert(!Loggable<length<furlong, double>>);     // not in the unit registry
+
+  // records
+
+  static_assert(std::is_trivially_copyable_v<log_record>);
+  static_assert(sizeof(log_record) == 16);
+
+  // not copyable
+
+  static_assert(!std::is_copy_constructible_v<log_format>);
+  static_assert(!std::is_copy_constructible_v<quantity_logger>);
+
+}  // namespace
@@ -0,0 +1,71 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/quantity_soa.h>
+#include <units/length.h>
+#include <units/time.h>
+#include <units/velocity.h>
+
+namespace {
+
+  using namespace units;
+
+  using state = quantity_soa<length<meter, double>, units::time<second, double>, velocity<meter_per_second, double>>;
+
+  // columns
+
+  static_assert(state::columns == 3);
+  static_assert(std::is_same_v<state::column_type<1>, units::time<second, double>>);
+  static_assert(std::is_same_v<decltype(std::declval<state&>().column<0>()), quantity_span<length<meter, double>>>);
+  static_assert(
+      std::is_same_v<decltype(std::declval<const state&>().column<0>()), quantity_span<const length<meter, double>>>);
+
+  // rows
+
+  static_assert(std::is_same_v<decltype(std::declval<state&>()[0].get<2>()), velocity<meter_per_second, double>&>);
+  static_assert(
+      std::is_same_v<decltype(std::declval<const state&>()[0].get<2>()), const velocity<meter_per_second, double>&>);
+  static_assert(std::is_convertible_v<state::reference, state::row_type>);
+  static_assert(std::is_assignable_v<state::reference, state::row_type>);
+  static_assert(!std::is_assignable_v<state::const_reference, state::row_type>);
+
+  // whole-column operations
+
+  using length_span = quantity_span<const length<meter, double>>;
+  using time_span = quantity_span<const units::time<second, double>>;
+  using velocity_span = quantity_span<velocity<meter_per_second, double>>;
+  using length_out_span = quantity_span<length<meter, double>>;
+
+  inline constexpr auto divide = [](auto a, auto b) { return a / b; };
+
+  template<typename Out, typename... In>
+  concept bool column_transformable = requires(Out out, In... in) {
+    transform_columns(out, divide, in...);
+  };
+
+  static_assert(column_transformable<velocity_span, length_span, time_span>);
+  static_assert(!column_transformable<length_out_span, length_span, time_span>);
+  using velocity_column = decltype(transform_columns(divide, std::declval<length_span>(), std::declval<time_span>()));
+  static_assert(std::is_same_v<velocity_column, std::vector<velocity<meter_per_second, double>>>);
+
+}  // namespace
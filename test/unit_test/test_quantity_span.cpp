@@ -0,0 +1,94 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/quantity_span.h>
+#include <units/length.h>
+#include <units/time.h>
+#include <array>
+
+namespace {
+
+  using namespace units;
+
+  // layout guarantees needed to view raw reps as quantities
+
+  static_assert(detail::is_rep_layout_compatible<length<meter, double>>);
+  static_assert(detail::is_rep_layout_compatible<length<kilometer, float>>);
+  static_assert(detail::is_rep_layout_compatible<units::time<microsecond, std::int32_t>>);
+  static_assert(detail::is_rep_layout_compatible<units::time<nanosecond, std::int64_t>>);
+
+  // member types
+
+  static_assert(std::is_same_v<quantity_span<length<meter, double>>::rep, double>);
+  static_assert(std::is_same_v<quantity_span<const length<meter, double>>::rep, const double>);
+  static_assert(std::is_same_v<quantity_span<const length<meter, double>>::value_type, length<meter, double>>);
+
+  // construction
+
+  static_assert(std::is_constructible_v<quantity_span<length<meter, double>>, std::array<length<meter, double>, 2>&>);
+  static_assert(std::is_convertible_v<std::array<length<meter, double>, 2>&, quantity_span<length<meter, double>>>);
+  static_assert(std::is_constructible_v<quantity_span<length<meter, double>>, std::array<double, 2>&>);
+  static_assert(!std::is_convertible_v<std::array<double, 2>&, quantity_span<length<meter, double>>>);
+  static_assert(!std::is_constructible_v<quantity_span<length<meter, double>>, std::array<float, 2>&>);
+  static_assert(!std::is_constructible_v<quantity_span<length<meter, double>>, const std::array<double, 2>&>);
+  static_assert(std::is_constructible_v<quantity_span<const length<meter, double>>, const std::array<double, 2>&>);
+  using span_m = quantity_span<length<meter, double>>;
+  using const_span_m = quantity_span<const length<meter, double>>;
+  static_assert(std::is_convertible_v<span_m, const_span_m>);
+  static_assert(!std::is_convertible_v<const_span_m, span_m>);
+
+  // element access
+
+  static_assert([] {
+    std::array<length<meter, int>, 3> a{length<meter, int>(1), length<meter, int>(2), length<meter, int>(3)};
+    quantity_span<length<meter, int>> s(a);
+    s[1] += 1_km;
+    return s.size() == 3 && s[1] == 1002_m && s.front() == 1_m && s.back() == 3_m && s.subspan(1, 2)[0] == 1002_m &&
+           s.last(1)[0] == 3_m;
+  }());
+
+  // quantity_span_cast
+
+  using converted_km = converted_quantity_span<length<kilometer, double>, length<meter, double>>;
+  static_assert(std::is_same_v<decltype(std::declval<converted_km>()[0]), length<kilometer, double>>);
+  static_assert(std::is_same_v<decltype(*std::declval<converted_km>().begin()), length<kilometer, double>>);
+  static_assert(std::is_same_v<decltype(quantity_span_cast<length<kilometer, double>>(std::declval<const_span_m>())),
+                               converted_quantity_span<length<kilometer, double>, const length<meter, double>>>);
+
+  static_assert([] {
+    const std::array<length<kilometer, int>, 3> a{length<kilometer, int>(1), length<kilometer, int>(2),
+                                                  length<kilometer, int>(3)};
+    const auto m = quantity_span_cast<length<meter, int>>(quantity_span<const length<kilometer, int>>(a));
+    int sum = 0;
+    for (auto l : m) sum += l.count();
+    return m.size() == 3 && m[1] == 2000_m && m.back() == 3000_m && sum == 6000 && a[1].count() == 2 &&
+           m.end() - m.begin() == 3 && *(m.begin() + 2) == 3000_m && m.source().data() == a.data();
+  }());
+
+  static_assert([] {
+    std::array<length<meter, int>, 2> a{length<meter, int>(1500), length<meter, int>(-500)};
+    const auto km = quantity_span_cast<length<kilometer, double>>(quantity_span<length<meter, int>>(a));
+    return km[0].count() == 1.5 && km[1].count() == -0.5 && a[0] == 1500_m;
+  }());
+
+}  // namespace
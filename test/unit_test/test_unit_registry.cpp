@@ -0,0 +1,78 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/unit_registry.h>
+
+namespace {
+
+  using namespace units;
+
+  // ids
+
+  static_assert(unit_registry::size == 34);
+  static_assert(unit_registry::id<meter> == 0);
+  static_assert(unit_id_of<kilometer> == 3);
+  static_assert(unit_id_of<mile_per_hour> == unit_registry::size - 1);
+  static_assert(unit_registry::contains<second>);
+  static_assert(!basic_unit_registry<unit_list<meter, second>>::contains<kilogram>);
+  static_assert(basic_unit_registry<unit_list<meter, second>>::id<second> == 1);
+
+  // tables
+
+  static_assert(unit_registry::symbols[unit_id_of<kilometer>] == "km");
+  static_assert(unit_registry::dimensions[unit_id_of<kilometer>] == packed_dimension::of<dimension_length>());
+  static_assert(unit_registry::ratios[unit_id_of<kilometer_per_hour>].num == 5);
+  static_assert(unit_registry::ratios[unit_id_of<kilometer_per_hour>].den == 18);
+  static_assert(unit_registry::magnitudes[unit_id_of<millisecond>] == 0.001);
+
+  // find
+
+  static_assert(unit_registry::find("m") == unit_id_of<meter>);
+  static_assert(unit_registry::find("km/h") == unit_id_of<kilometer_per_hour>);
+  static_assert(unit_registry::find("kmph") == unit_id_of<kilometer_per_hour>);
+  static_assert(unit_registry::find("µs") == unit_id_of<microsecond>);
+  static_assert(unit_registry::find("us") == unit_id_of<microsecond>);
+  static_assert(unit_registry::find("m^2") == unit_id_of<square_meter>);
+  static_assert(!unit_registry::find("M"));
+  static_assert(!unit_registry::find(""));
+
+  // conversion_factor
+
+  static_assert(unit_registry::conversion_factor(unit_id_of<kilometer>, unit_id_of<meter>) == 1000);
+  static_assert(unit_registry::conversion_factor(unit_id_of<meter>, unit_id_of<kilometer>) == 0.001);
+  static_assert(unit_registry::conversion_factor(unit_id_of<hour>, unit_id_of<minute>) == 60);
+
+  // make_dynamic
+
+  static_assert(unit_registry::make_dynamic(unit_id_of<kilometer>, 2).coherent_value() == 2000);
+  static_assert(unit_registry::make_dynamic(unit_id_of<second>, 1).dimension() ==
+                packed_dimension::of<dimension_time>());
+
+  // perfect_hash
+
+  constexpr std::array<std::string_view, 3> keys{"a", "b", "c"};
+  constexpr auto hash = detail::make_perfect_hash(keys);
+  static_assert(hash.find("b", keys) == 1);
+  static_assert(hash.find("d", keys) == 3);
+
+}  // namespace
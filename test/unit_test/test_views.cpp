@@ -0,0 +1,66 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <units/views.h>
+#include <units/length.h>
+#include <units/time.h>
+#include <array>
+
+namespace {
+
+  using namespace units;
+
+  // conversion factor folding
+
+  static_assert(!detail::quantity_converter<length<meter, double>, length<kilometer, double>>::folded);
+  static_assert(detail::quantity_converter<length<kilometer, double>, length<meter, double>>::folded);
+  static_assert(!detail::quantity_converter<length<meter, int>, length<kilometer, int>>::folded);
+  static_assert(!detail::quantity_converter<length<kilometer, int>, length<meter, int>>::folded);
+
+  static_assert(detail::quantity_converter<length<meter, double>, length<kilometer, double>>{}(2.5_km) == 2500_m);
+  static_assert(detail::quantity_converter<length<kilometer, double>, length<meter, double>>{}(500.0_m) > 499.999_m);
+  static_assert(detail::quantity_converter<length<kilometer, double>, length<meter, double>>{}(500.0_m) < 500.001_m);
+  static_assert(detail::quantity_converter<length<meter, int>, length<kilometer, int>>{}(2_km) == 2000_m);
+  static_assert(detail::quantity_converter<units::time<second, int>, units::time<millisecond, int>>{}(1999_ms) == 1_s);
+
+  // element functions
+
+  static_assert(detail::to_quantity_fn<length<meter, int>>{}(3) == 3_m);
+  static_assert(detail::quantity_cast_fn<length<meter, int>>{}(3_km) == 3000_m);
+  static_assert(detail::count_fn{}(3_km) == 3);
+
+  static_assert(!std::is_invocable_v<detail::to_quantity_fn<length<meter, int>>, double>);
+  static_assert(!std::is_invocable_v<detail::quantity_cast_fn<length<meter, int>>, units::time<second, int>>);
+
+  // adaptors
+
+  using raw_km = std::array<double, 3>;
+  using km_range = decltype(std::declval<raw_km&>() | views::as_quantity<length<kilometer, double>>);
+  using m_range = decltype(std::declval<km_range>() | views::quantity_cast<length<meter, double>>);
+  using count_range = decltype(std::declval<m_range>() | views::count);
+
+  static_assert(std::is_same_v<decltype(*std::declval<km_range&>().begin()), length<kilometer, double>>);
+  static_assert(std::is_same_v<decltype(*std::declval<m_range&>().begin()), length<meter, double>>);
+  static_assert(std::is_same_v<decltype(*std::declval<count_range&>().begin()), double>);
+
+}  // namespace